@@ -0,0 +1,107 @@
+// Micro benchmark for per-subscriber event dispatch cost.
+//
+// Compares the Dispatcher used by EventRouter with the previous approach of
+// a signal whose slots are boost::bind adaptors wrapped in tr1::function.
+// Boost.Signals (v1) is no longer shipped with Boost so Boost.Signals2 is
+// used as the stand-in for the previous signal implementation.
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <tr1/functional>
+#include <boost/any.hpp>
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/signals2.hpp>
+#include <EventRouter.h>
+
+using namespace j2;
+
+static unsigned long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw() {
+    std::free(p);
+}
+
+// Adaptor in the style previously used by Subscription::assign_to
+template <typename T> struct LEGACY_PTR_ADAPTOR {
+    static void ADAPT(const std::string&, const boost::any item, T* ptr) {
+        *ptr = boost::any_cast<T>(item);
+    }
+};
+
+typedef boost::signals2::signal<void (const std::string&, const boost::any)> LegacySignal;
+
+struct Result {
+    double ns_per_subscriber;
+    double allocations_per_emit;
+};
+
+static Result run_legacy(int subscribers, int iterations) {
+    LegacySignal signal;
+    std::vector<double> values(subscribers);
+    for (int i = 0; i < subscribers; i++) {
+        std::tr1::function<void (const std::string&, const boost::any, double*)> adapt =
+            LEGACY_PTR_ADAPTOR<double>::ADAPT;
+        signal.connect(boost::bind(adapt, _1, _2, &values[i]));
+    }
+    const std::string name("/motion/hoist");
+    const boost::any value(1.0);
+    unsigned long start_allocations = allocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) signal(name, value);
+    Clock::duration elapsed = Clock::now() - start;
+    Result result;
+    result.ns_per_subscriber =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) /
+        (double(iterations) * subscribers);
+    result.allocations_per_emit = double(allocations - start_allocations) / iterations;
+    return result;
+}
+
+static Result run_dispatcher(int subscribers, int iterations) {
+    SignalPtr signal(new Signal());
+    std::vector<double> values(subscribers);
+    for (int i = 0; i < subscribers; i++) {
+        signal->connect(ANY_PTR_ADAPTOR<double, double*>(&values[i]));
+    }
+    const std::string name("/motion/hoist");
+    const boost::any value(1.0);
+    unsigned long start_allocations = allocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) (*signal)(name, value);
+    Clock::duration elapsed = Clock::now() - start;
+    Result result;
+    result.ns_per_subscriber =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) /
+        (double(iterations) * subscribers);
+    result.allocations_per_emit = double(allocations - start_allocations) / iterations;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const int ITERATIONS = argc > 1 ? atoi(argv[1]) : 200000;
+    const int SUBSCRIBERS[] = { 1, 4, 16, 64 };
+
+    printf("%-12s %24s %24s\n", "subscribers", "signal+bind ns (allocs)", "Dispatcher ns (allocs)");
+    for (unsigned i = 0; i < sizeof(SUBSCRIBERS) / sizeof(SUBSCRIBERS[0]); i++) {
+        Result legacy = run_legacy(SUBSCRIBERS[i], ITERATIONS);
+        Result dispatcher = run_dispatcher(SUBSCRIBERS[i], ITERATIONS);
+        printf("%-12d %15.2f (%6.2f) %15.2f (%6.2f)\n",
+               SUBSCRIBERS[i],
+               legacy.ns_per_subscriber, legacy.allocations_per_emit,
+               dispatcher.ns_per_subscriber, dispatcher.allocations_per_emit);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+// Benchmark of Modbus polling over a slow link.
+//
+// Polls a block of holding registers from a loopback stand-in server that
+// holds back every response by a fixed latency, and reports the polls per
+// second for an increasing number of requests in flight.  With one in
+// flight each poll costs a full round trip, as with the blocking ModbusTcp
+// helpers; deeper pipelines should scale nearly linearly until the server
+// or the link saturates.
+#include <cstdio>
+#include <cstdlib>
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <ModbusClient.h>
+#include <ModbusLoopbackServer.h>
+
+using namespace j2;
+
+static void poll_again(ModbusClient* client, long* responses, const ModbusTcpMessage&);
+
+static void poll(ModbusClient* client, long* responses) {
+    client->request(ReadHoldingRegistersRequest(0, 32), boost::bind(poll_again, client, responses, _1));
+}
+
+// Keep the pipeline full by issuing a new poll for each response
+static void poll_again(ModbusClient* client, long* responses, const ModbusTcpMessage&) {
+    (*responses)++;
+    poll(client, responses);
+}
+
+static double run(std::size_t pipeline, boost::chrono::milliseconds latency, int polls) {
+    ModbusLoopbackServer server(1024, latency);
+    Reactor reactor;
+    ModbusClient client(reactor, 1, pipeline);
+    client.connect("127.0.0.1", server.port());
+    long responses = 0;
+
+    Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < pipeline; i++) poll(&client, &responses);
+    while (responses < polls) reactor.wait(EventClock::duration(boost::chrono::milliseconds(100)));
+    Clock::duration elapsed = Clock::now() - start;
+
+    double seconds = double(boost::chrono::duration_cast<boost::chrono::microseconds>(elapsed).count()) / 1e6;
+    return double(responses) / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    const int POLLS = argc > 1 ? atoi(argv[1]) : 400;
+    const boost::chrono::milliseconds LATENCY(argc > 2 ? atoi(argv[2]) : 5);
+
+    printf("latency %ld ms\n", (long)LATENCY.count());
+    printf("%-10s %16s\n", "pipeline", "polls/s");
+    for (std::size_t pipeline = 1; pipeline <= 16; pipeline *= 2) {
+        printf("%-10lu %16.0f\n", (unsigned long)pipeline, run(pipeline, LATENCY, POLLS));
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Micro benchmark for decoding Modbus responses.
+//
+// Decodes a full read holding registers response, as received from a PLC,
+// with ModbusTcp::read_response, with ModbusFrame views over the receive
+// buffer and into a reused ModbusPdu, then answers the matching request
+// with ModbusServer::respond, and reports the time and heap allocations
+// per frame.  All but the first should make no allocations at all.  Last,
+// polls a ModbusServer on the same reactor with ModbusClient::request_pdu,
+// which should make no allocations per round trip either.
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <boost/chrono.hpp>
+#include <Modbus.h>
+#include <ModbusFrame.h>
+#include <ModbusPdu.h>
+#include <ModbusClient.h>
+#include <ModbusServer.h>
+
+using namespace j2;
+
+static unsigned long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw() {
+    std::free(p);
+}
+
+struct Result {
+    double ns_per_frame;
+    double allocations_per_frame;
+};
+
+static unsigned long checksum = 0;
+
+static void decode_message(const buffer& received) {
+    SpanIoReader reader((ByteSpan(received)));
+    ModbusTcpMessage message = ModbusTcp::read_response(reader);
+    const std::vector<uint16_t>& registers = message.message<ReadHoldingRegistersResponse>().registers;
+    for (std::size_t i = 0; i < registers.size(); i++) checksum += registers[i];
+}
+
+static void decode_frame(const buffer& received) {
+    ModbusFrame frame;
+    ReadHoldingRegistersResponseView response;
+    if (frame.parse(ByteSpan(received)) != ModbusFrame::Complete || !response.parse(frame)) return;
+    for (std::size_t i = 0; i < response.registers.size(); i++) checksum += response.registers[i];
+}
+
+static void decode_pdu(const buffer& received) {
+    static ModbusPdu pdu;
+    ModbusFrame frame;
+    if (frame.parse(ByteSpan(received)) != ModbusFrame::Complete || !pdu.decode_response(frame)) return;
+    const ModbusPdu::ReadResponse& response = pdu.read_response();
+    for (std::size_t i = 0; i < response.numberOfRegisters; i++) checksum += response.registers[i];
+}
+
+static ModbusRegisterImage image(1024);
+static shared_buffer response(new buffer);
+
+static void respond(const buffer& received) {
+    ModbusFrame frame;
+    if (frame.parse(ByteSpan(received)) != ModbusFrame::Complete) return;
+    response->clear();
+    MemoryIoWriter writer(response);
+    ModbusServer::respond(image, frame, writer);
+    checksum += response->size();
+}
+
+static long polled = 0;
+
+static void count_response(uint16_t, const ModbusPdu& response) {
+    if (response.kind() == ModbusPdu::ReadHoldingRegistersResponsePdu) polled++;
+}
+
+static Result poll(int iterations) {
+    Reactor reactor;
+    ModbusServer server(reactor, image);
+    server.listen("127.0.0.1", 0);
+    ModbusClient client(reactor);
+    client.connect("127.0.0.1", server.port());
+    ModbusPdu request;
+    request.make_read_request().numberOfRegisters = 125;
+
+    // Let the buffers grow to the traffic before counting
+    unsigned long start_allocations = 0;
+    Clock::time_point start;
+    for (int i = -100; i < iterations; i++) {
+        if (i == 0) {
+            start_allocations = allocations;
+            start = Clock::now();
+        }
+        long expected = polled + 1;
+        client.request_pdu(request, count_response);
+        while (polled < expected) reactor.wait(EventClock::duration(boost::chrono::milliseconds(100)));
+    }
+    Clock::duration elapsed = Clock::now() - start;
+
+    Result result;
+    result.ns_per_frame =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) / iterations;
+    result.allocations_per_frame = double(allocations - start_allocations) / iterations;
+    return result;
+}
+
+static Result run(void (*decode)(const buffer&), const buffer& received, int iterations) {
+    unsigned long start_allocations = allocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) decode(received);
+    Clock::duration elapsed = Clock::now() - start;
+
+    Result result;
+    result.ns_per_frame =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) / iterations;
+    result.allocations_per_frame = double(allocations - start_allocations) / iterations;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const int ITERATIONS = argc > 1 ? atoi(argv[1]) : 100000;
+
+    std::vector<uint16_t> registers;
+    for (uint16_t i = 0; i < 125; i++) registers.push_back(i);
+    shared_buffer received(new buffer);
+    MemoryIoWriter writer(received);
+    ModbusTcpMessage(uint16_t(1), uint16_t(1), ReadHoldingRegistersResponse(registers)).serialize(writer);
+
+    shared_buffer request(new buffer);
+    MemoryIoWriter request_writer(request);
+    ModbusTcp::write_request(request_writer, ReadHoldingRegistersRequest(0, 125), 1, 1);
+    response->reserve(MODBUS_TCP_MAX_FRAME);
+
+    Result message = run(decode_message, *received, ITERATIONS);
+    Result frame = run(decode_frame, *received, ITERATIONS);
+    Result pdu = run(decode_pdu, *received, ITERATIONS);
+    Result served = run(respond, *request, ITERATIONS);
+    Result polls = poll(ITERATIONS / 10);
+    printf("%-22s %12s %16s\n", "decoder", "ns/frame", "allocs/frame");
+    printf("%-22s %12.1f %16.2f\n", "ModbusTcp::read", message.ns_per_frame, message.allocations_per_frame);
+    printf("%-22s %12.1f %16.2f\n", "ModbusFrame", frame.ns_per_frame, frame.allocations_per_frame);
+    printf("%-22s %12.1f %16.2f\n", "ModbusPdu", pdu.ns_per_frame, pdu.allocations_per_frame);
+    printf("%-22s %12.1f %16.2f\n", "ModbusServer::respond", served.ns_per_frame, served.allocations_per_frame);
+    printf("%-22s %12.1f %16.2f\n", "ModbusClient poll", polls.ns_per_frame, polls.allocations_per_frame);
+    return checksum == 0;
+}
@@ -0,0 +1,88 @@
+// Micro benchmark for handing items between threads.
+//
+// Compares blocking_queue with the lock-free spsc_queue and mpsc_queue for
+// one and several producer threads feeding a single consumer, reporting the
+// time per item and the number of context switches per thousand items.
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+#include <blocking_queue.h>
+#include <ring_queue.h>
+
+using namespace j2;
+
+typedef boost::chrono::high_resolution_clock Clock;
+
+struct Result {
+    double ns_per_item;
+    double switches_per_1000;
+};
+
+static long context_switches() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+template <class Queue>
+static void produce(Queue* queue, int count) {
+    for (int i = 0; i < count; i++) queue->enq(i);
+}
+
+template <class Queue>
+static Result run(Queue& queue, int producers, int items) {
+    int per_producer = items / producers;
+    long start_switches = context_switches();
+    Clock::time_point start = Clock::now();
+    boost::thread_group threads;
+    for (int p = 0; p < producers; p++) {
+        threads.create_thread(boost::bind(produce<Queue>, &queue, per_producer));
+    }
+    long sum = 0;
+    for (int i = 0; i < per_producer * producers; i++) sum += queue.deq();
+    threads.join_all();
+    Clock::duration elapsed = Clock::now() - start;
+    Result result;
+    result.ns_per_item =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) /
+        (double(per_producer) * producers);
+    result.switches_per_1000 =
+        1000.0 * double(context_switches() - start_switches) / (double(per_producer) * producers);
+    if (sum < 0) printf("unexpected sum\n");
+    return result;
+}
+
+static void print(const char* name, int producers, const Result& result) {
+    printf("%-16s %10d %12.2f %16.2f\n", name, producers, result.ns_per_item, result.switches_per_1000);
+}
+
+int main(int argc, char* argv[]) {
+    const int ITEMS = argc > 1 ? atoi(argv[1]) : 1000000;
+    const int PRODUCERS = 4;
+
+    printf("%-16s %10s %12s %16s\n", "queue", "producers", "ns/item", "switches/1000");
+    {
+        blocking_queue<int> queue;
+        print("blocking_queue", 1, run(queue, 1, ITEMS));
+    }
+    {
+        spsc_queue<int> queue;
+        print("spsc_queue", 1, run(queue, 1, ITEMS));
+    }
+    {
+        mpsc_queue<int> queue;
+        print("mpsc_queue", 1, run(queue, 1, ITEMS));
+    }
+    {
+        blocking_queue<int> queue;
+        print("blocking_queue", PRODUCERS, run(queue, PRODUCERS, ITEMS));
+    }
+    {
+        mpsc_queue<int> queue;
+        print("mpsc_queue", PRODUCERS, run(queue, PRODUCERS, ITEMS));
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Micro benchmark for routing events from the central router into a Module.
+//
+// Measures the time and number of heap allocations per event between
+// publishing on the central router and the module processing the event,
+// without and with the module's telemetry enabled, and what telemetry adds
+// per event when every event is processed on its own.
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <boost/chrono.hpp>
+#include <Module.h>
+
+using namespace j2;
+
+static unsigned long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw() {
+    std::free(p);
+}
+
+struct Sample {
+    Sample() : position(0), velocity(0) { }
+    Sample(double position, double velocity) : position(position), velocity(velocity) { }
+    double position;
+    double velocity;
+};
+
+class BenchmarkModule : public Module {
+public:
+    BenchmarkModule(EventRouter* router) : Module(router) {
+        bind_value("/motion/hoist", &hoist);
+    }
+
+    Sample hoist;
+};
+
+struct Result {
+    double ns_per_event;
+    double allocations_per_event;
+};
+
+// Publish batches of events through a typed channel and process them
+static Result run(int batch, int iterations, bool telemetry) {
+    EventRouter* router = new EventRouter();
+    BenchmarkModule module(router);
+    module.enable_telemetry(telemetry);
+    Channel<Sample> hoist = router->channel<Sample>("/motion/hoist");
+
+    // Warm up so that the queue reaches its working size
+    for (int i = 0; i < batch; i++) hoist.publish(Sample(i, 0));
+    module.process_all();
+
+    unsigned long start_allocations = allocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (int j = 0; j < batch; j++) hoist.publish(Sample(j, 0));
+        module.process_all();
+    }
+    Clock::duration elapsed = Clock::now() - start;
+    Result result;
+    result.ns_per_event =
+        double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) /
+        (double(iterations) * batch);
+    result.allocations_per_event = double(allocations - start_allocations) / (double(iterations) * batch);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const int ITERATIONS = argc > 1 ? atoi(argv[1]) : 20000;
+    const int BATCHES[] = { 1, 16, 256, 1024 };
+
+    printf("%-12s %-10s %16s %16s\n", "batch", "telemetry", "ns/event", "allocs/event");
+    for (int telemetry = 0; telemetry < 2; telemetry++) {
+        for (unsigned i = 0; i < sizeof(BATCHES) / sizeof(BATCHES[0]); i++) {
+            Result result = run(BATCHES[i], ITERATIONS / BATCHES[i] + 1, telemetry);
+            printf("%-12d %-10s %16.2f %16.2f\n", BATCHES[i], telemetry ? "on" : "off",
+                   result.ns_per_event, result.allocations_per_event);
+        }
+    }
+
+    // The difference is small next to the noise of a single run, so take
+    // the best of alternating runs
+    double best[2] = { 0, 0 };
+    for (int round = 0; round < 10; round++) {
+        for (int telemetry = 0; telemetry < 2; telemetry++) {
+            double ns = run(1, ITERATIONS, telemetry).ns_per_event;
+            if (round == 0 || ns < best[telemetry]) best[telemetry] = ns;
+        }
+    }
+    printf("telemetry cost at batch 1: %.2f ns/event\n", best[1] - best[0]);
+    return 0;
+}
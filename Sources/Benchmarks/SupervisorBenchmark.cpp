@@ -0,0 +1,63 @@
+// Benchmark of the threaded Supervisor.
+//
+// Loads many independent modules, each doing a fixed amount of work per
+// event, and reports the throughput of the worker pool for an increasing
+// number of threads.  Throughput should grow with the threads up to the
+// number of cores.
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+#include <Supervisor.h>
+
+using namespace j2;
+
+static boost::atomic<long> processed(0);
+
+class WorkModule : public Module {
+public:
+    WorkModule(std::tr1::shared_ptr<EventRouter> router) : Module(router), _sum(0) {
+        bind_fn<int>("work", boost::bind(&WorkModule::work, this, _1));
+    }
+
+    void work(int value) {
+        for (int i = 0; i < 2000; i++) _sum += value * i;
+        processed.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+private:
+    volatile long _sum;
+};
+
+static double run(std::size_t threads, int modules, int events) {
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    for (int i = 0; i < modules; i++) supervisor.load<WorkModule>();
+    processed.store(0);
+    long expected = long(modules) * events;
+
+    Clock::time_point start = Clock::now();
+    supervisor.start(threads);
+    for (int i = 0; i < events; i++) router->publish("work", i);
+    while (processed.load() < expected) boost::this_thread::yield();
+    Clock::duration elapsed = Clock::now() - start;
+    supervisor.stop();
+
+    double seconds = double(boost::chrono::duration_cast<boost::chrono::microseconds>(elapsed).count()) / 1e6;
+    return double(expected) / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    const int EVENTS = argc > 1 ? atoi(argv[1]) : 2000;
+    const int MODULES = 64;
+    std::size_t cores = boost::thread::hardware_concurrency();
+
+    printf("%-10s %16s\n", "threads", "events/s");
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2) {
+        printf("%-10lu %16.0f\n", (unsigned long)threads, run(threads, MODULES, EVENTS));
+    }
+    return 0;
+}
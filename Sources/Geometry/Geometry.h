@@ -64,19 +64,29 @@ namespace j2 {
     class GeometryManager : public Module {
     public:
         GeometryManager() {
-            bind_value("/motion/hoist", &_hoist_motion);
-            bind_value("/motion/drag", &_drag_motion);
-            bind_value("/motion/swing", &_swing_motion);
-            bind_value("/sheave/hoist", &_hoist_sheave);
-            bind_value("/sheave/drag", &_drag_sheave);
-            bind_value("/sensor/inclinometer/pitch", &_pitch);
+            // Recompute once per sensor cycle, when every input has a new
+            // sample within the jitter tolerance
+            Join& inputs = join(boost::bind(&GeometryManager::update, this),
+                                boost::chrono::milliseconds(MAX_GEOMETRY_JITTER_MS));
+            bind_value("/motion/hoist", &_hoist_motion, inputs);
+            bind_value("/motion/drag", &_drag_motion, inputs);
+            bind_value("/motion/swing", &_swing_motion, inputs);
+            bind_value("/sheave/hoist", &_hoist_sheave, inputs);
+            bind_value("/sheave/drag", &_drag_sheave, inputs);
+            bind_value("/sensor/inclinometer/pitch", &_pitch, inputs);
             bind_value("/config/geometry", &_config);
 
             _set +=_hoist_motion, _drag_motion, _swing_motion, _hoist_sheave,
                 _drag_sheave, _pitch;
         }
 
-        void update();
+        /**
+         * @brief Recompute the geometry from the latest inputs.  Called once
+         * per complete set of new sensor samples; may also be run every
+         * MAX_GEOMETRY_JITTER_MS by giving the module that period in a
+         * @c DeadlineScheduler.
+         */
+        virtual void update();
 
     private:
         bool has_slack_rope() const {
@@ -92,7 +102,7 @@ namespace j2 {
         }
 
     private:
-        TimestampedSet<MAX_GEOMETRY_JITTER_MS, boost::chrono::milliseconds> _set;
+        IncrementalTimestampedSet<MAX_GEOMETRY_JITTER_MS, boost::chrono::milliseconds> _set;
         Timestamped<Geometry> _geometry;
         GeometryConfig _config;
         Timestamped<Motion> _hoist_motion;
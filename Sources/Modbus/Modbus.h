@@ -24,7 +24,8 @@ namespace j2 {
         
         static ModbusTcpMessage read_response(IoReader& reader);
 
-        static void write_request(IoWriter& writer, const ModbusRequest& request);
+        static void write_request(IoWriter& writer, const ModbusRequest& request,
+                                  uint16_t transactionId = 0, uint8_t unitId = 0);
 
         static void write_response(IoWriter& writer, 
                                    const ModbusTcpMessage& request,
@@ -36,7 +37,7 @@ namespace j2 {
         ModbusTcpMessage message;
         message.deserialize(reader);
         ModbusMessage* modbus_message = create_message((ModbusFunctionCode)message.functionCode);
-        MemoryIoReader data_reader(message.data());
+        SpanIoReader data_reader((ByteSpan(message.data())));
         modbus_message->deserialize(data_reader);
         message.message(modbus_message);
         return message;    
@@ -50,8 +51,9 @@ namespace j2 {
         return read(reader, ModbusMessage::response_for);
     }
 
-    inline void ModbusTcp::write_request(IoWriter& writer, const ModbusRequest& request) {
-        ModbusTcpMessage(uint16_t(0), uint16_t(0), request).serialize(writer);
+    inline void ModbusTcp::write_request(IoWriter& writer, const ModbusRequest& request,
+                                         uint16_t transactionId, uint8_t unitId) {
+        ModbusTcpMessage(transactionId, unitId, request).serialize(writer);
     }
 
     inline void ModbusTcp::write_response(IoWriter& writer, 
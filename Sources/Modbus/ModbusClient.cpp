@@ -0,0 +1,351 @@
+#include <cerrno>
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include "ModbusClient.h"
+
+using namespace j2;
+
+namespace {
+    const std::size_t READ_CHUNK = 4096;
+
+    void throw_errno(const std::string& what) {
+        throw ModbusException(what + ": " + strerror(errno));
+    }
+}
+
+ModbusClient::ModbusClient(Reactor& reactor,
+                           uint8_t unitId,
+                           std::size_t pipeline,
+                           EventClock::duration timeout) :
+    _reactor(reactor),
+    _fd(-1),
+    _writing(false),
+    _unitId(unitId),
+    _pipeline(pipeline > 0 ? pipeline : 1),
+    _timeout(timeout),
+    _next_id(0),
+    _pending(_pipeline),
+    _outstanding(0),
+    _output(new buffer) { }
+
+ModbusClient::~ModbusClient() {
+    // Whatever the handlers refer to may already be gone
+    for (std::size_t i = 0; i < _pending.size(); i++) _pending[i] = Pending();
+    _outstanding = 0;
+    _queue.clear();
+    close();
+}
+
+void ModbusClient::connect(const std::string& host, uint16_t port) {
+    // Requests made before connecting stay queued
+    if (_fd >= 0) close();
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = 0;
+    std::string service = boost::lexical_cast<std::string>(port);
+    int error = getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+    if (error != 0) {
+        throw ModbusException("Cannot resolve " + host + ": " + gai_strerror(error));
+    }
+
+    int fd = -1;
+    for (struct addrinfo* address = addresses; address && fd < 0; address = address->ai_next) {
+        fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) < 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) throw_errno("Cannot connect to " + host);
+
+    // Requests are small and latency matters more than packet count
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    _fd = fd;
+    _writing = false;
+    _reactor.watch(_fd, boost::bind(&ModbusClient::ready, this));
+    send_queued();
+}
+
+void ModbusClient::close() {
+    if (_fd >= 0) {
+        _reactor.unwatch(_fd);
+        ::close(_fd);
+        _fd = -1;
+    }
+    _input.clear();
+    _output->clear();
+    fail_all(GatewayPathUnavailable);
+}
+
+uint16_t ModbusClient::enqueue(const ModbusRequest& request, Handler handler, FrameHandler frame_handler) {
+    Queued queued;
+    queued.transactionId = next_transaction_id();
+    queued.functionCode = uint8_t(request.functionCode());
+    queued.handler = handler;
+    queued.frame_handler = frame_handler;
+    shared_buffer frame(new buffer);
+    MemoryIoWriter writer(frame);
+    ModbusTcp::write_request(writer, request, queued.transactionId, _unitId);
+    queued.frame.swap(*frame);
+    _queue.push_back(queued);
+    if (_fd >= 0) send_queued();
+    return queued.transactionId;
+}
+
+uint16_t ModbusClient::request_pdu(const ModbusPdu& request, PduHandler handler) {
+    uint16_t transactionId = next_transaction_id();
+    if (_fd < 0 || !_queue.empty() || _outstanding >= _pipeline) {
+        Queued queued;
+        queued.transactionId = transactionId;
+        queued.functionCode = request.functionCode();
+        queued.pdu_handler = handler;
+        shared_buffer frame(new buffer);
+        MemoryIoWriter writer(frame);
+        request.write(writer, transactionId, _unitId);
+        queued.frame.swap(*frame);
+        _queue.push_back(queued);
+        if (_fd >= 0) send_queued();
+        return transactionId;
+    }
+    Pending& pending = start(transactionId, request.functionCode(), EventClock::now());
+    pending.pdu_handler.swap(handler);
+    MemoryIoWriter writer(_output);
+    request.write(writer, transactionId, _unitId);
+    flush();
+    return transactionId;
+}
+
+std::size_t ModbusClient::expire(EventClock::time_point now) {
+    std::size_t expired = 0;
+    for (std::size_t i = 0; i < _pending.size(); i++) {
+        if (!_pending[i].active || now - _pending[i].sent < _timeout) continue;
+        // Take the request first, since the handler may make new ones
+        Pending pending;
+        std::swap(pending, _pending[i]);
+        _outstanding--;
+        _stats.timeouts++;
+        expired++;
+        fail(pending.transactionId, pending.functionCode, GatewayTargetFailedToRespond,
+             pending.handler, pending.frame_handler, pending.pdu_handler);
+    }
+    // A late response would now be unmatched, so the freed slots can be used
+    if (expired > 0 && _fd >= 0) send_queued();
+    return expired;
+}
+
+uint16_t ModbusClient::next_transaction_id() {
+    // Zero is left to the blocking ModbusTcp helpers
+    do {
+        _next_id++;
+    } while (_next_id == 0 || find_pending(_next_id));
+    return _next_id;
+}
+
+// The table is only as long as the pipeline, a handful of slots, so
+// scanning it is as quick as any index would be
+ModbusClient::Pending* ModbusClient::find_pending(uint16_t transactionId) {
+    for (std::size_t i = 0; i < _pending.size(); i++) {
+        if (_pending[i].active && _pending[i].transactionId == transactionId) return &_pending[i];
+    }
+    return 0;
+}
+
+ModbusClient::Pending& ModbusClient::start(uint16_t transactionId, uint8_t functionCode,
+                                           EventClock::time_point now) {
+    assert(_outstanding < _pipeline);
+    std::size_t slot = 0;
+    while (_pending[slot].active) slot++;
+    Pending& pending = _pending[slot];
+    pending.active = true;
+    pending.transactionId = transactionId;
+    pending.functionCode = functionCode;
+    pending.sent = now;
+    _outstanding++;
+    _stats.requests++;
+    return pending;
+}
+
+// The caller has taken the handler already
+void ModbusClient::finish(Pending& pending) {
+    pending.active = false;
+    _outstanding--;
+    _stats.responses++;
+}
+
+void ModbusClient::send_queued() {
+    EventClock::time_point now = EventClock::now();
+    while (!_queue.empty() && _outstanding < _pipeline) {
+        Queued& queued = _queue.front();
+        Pending& pending = start(queued.transactionId, queued.functionCode, now);
+        pending.handler.swap(queued.handler);
+        pending.frame_handler.swap(queued.frame_handler);
+        pending.pdu_handler.swap(queued.pdu_handler);
+        _output->insert(_output->end(), queued.frame.begin(), queued.frame.end());
+        _queue.pop_front();
+    }
+    flush();
+}
+
+// A write only falls short when the server is slow to read, and what is
+// left is sent once the socket is writable again.
+void ModbusClient::flush() {
+    buffer& output = *_output;
+    std::size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t written = send(_fd, &output[sent], output.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            close();
+            return;
+        }
+        sent += std::size_t(written);
+    }
+    output.erase(output.begin(), output.begin() + sent);
+
+    // Only watch for writability while output is left, since an idle
+    // socket is always writable
+    bool writing = !output.empty();
+    if (writing != _writing) {
+        int events = writing ? Reactor::Readable | Reactor::Writable : Reactor::Readable;
+        _reactor.watch(_fd, boost::bind(&ModbusClient::ready, this), events);
+        _writing = writing;
+    }
+}
+
+void ModbusClient::ready() {
+    uint8_t chunk[READ_CHUNK];
+    bool closed = false;
+    for (;;) {
+        ssize_t got = recv(_fd, chunk, sizeof(chunk), 0);
+        if (got > 0) {
+            _input.insert(_input.end(), chunk, chunk + got);
+            continue;
+        }
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        // Closed by the server, or failed, but answer what was received first
+        closed = true;
+        break;
+    }
+
+    // Frames point into the input, so keep it here in case a handler closes
+    // the connection, which clears the member
+    buffer input;
+    input.swap(_input);
+    ByteSpan unparsed(input);
+    for (;;) {
+        ModbusFrame frame;
+        ModbusFrame::Status status = frame.parse(unparsed);
+        if (status == ModbusFrame::Incomplete) break;
+        if (status == ModbusFrame::Invalid) {
+            // Framing is lost, so nothing after this can be trusted
+            close();
+            return;
+        }
+        ByteSpan bytes = unparsed.subspan(0, frame.frame_size());
+        unparsed = unparsed.subspan(frame.frame_size());
+
+        Pending* pending = find_pending(frame.transactionId);
+        if (!pending) {
+            _stats.unmatched++;
+            continue;
+        }
+        if (pending->frame_handler) {
+            FrameHandler handler;
+            handler.swap(pending->frame_handler);
+            finish(*pending);
+            handler(frame);
+        } else if (pending->pdu_handler) {
+            if (!_response.decode_response(frame)) {
+                _stats.unmatched++;
+                continue;
+            }
+            PduHandler handler;
+            handler.swap(pending->pdu_handler);
+            finish(*pending);
+            handler(frame.transactionId, _response);
+        } else {
+            SpanIoReader reader(bytes);
+            ModbusTcpMessage response = ModbusTcp::read_response(reader);
+            if (reader.hasError()) {
+                _stats.unmatched++;
+                continue;
+            }
+            Handler handler;
+            handler.swap(pending->handler);
+            finish(*pending);
+            handler(response);
+        }
+        // The handler may have closed the connection
+        if (_fd < 0) return;
+    }
+    input.erase(input.begin(), input.end() - unparsed.size());
+    _input.swap(input);
+    if (closed) {
+        close();
+        return;
+    }
+    send_queued();
+}
+
+void ModbusClient::fail(uint16_t transactionId, uint8_t functionCode, ModbusExceptionCode code,
+                        const Handler& handler, const FrameHandler& frame_handler,
+                        const PduHandler& pdu_handler) {
+    if (pdu_handler) {
+        ModbusPdu exception;
+        exception.make_exception(functionCode, code);
+        pdu_handler(transactionId, exception);
+        return;
+    }
+    if (frame_handler) {
+        const uint8_t bytes[] = {
+            uint8_t(transactionId >> 8), uint8_t(transactionId & 0xff), 0, 0, 0, 3,
+            _unitId, uint8_t(functionCode | MODBUS_EXCEPTION_FLAG), uint8_t(code)
+        };
+        ModbusFrame frame;
+        frame.parse(ByteSpan(bytes, sizeof(bytes)));
+        frame_handler(frame);
+        return;
+    }
+    ModbusResponse* exception =
+        new ModbusExceptionMessage(functionCode | MODBUS_EXCEPTION_FLAG, code);
+    ModbusTcpMessage response(transactionId, _unitId, *exception);
+    response.message(exception);
+    handler(response);
+}
+
+void ModbusClient::fail_all(ModbusExceptionCode code) {
+    // Take the requests first, since handlers may make new ones
+    std::vector<Pending> pending(_pending.size());
+    pending.swap(_pending);
+    _outstanding = 0;
+    std::deque<Queued> queue;
+    queue.swap(_queue);
+    for (std::vector<Pending>::iterator it = pending.begin(); it != pending.end(); ++it) {
+        if (!it->active) continue;
+        _stats.failures++;
+        fail(it->transactionId, it->functionCode, code, it->handler, it->frame_handler, it->pdu_handler);
+    }
+    for (std::deque<Queued>::iterator it = queue.begin(); it != queue.end(); ++it) {
+        _stats.failures++;
+        fail(it->transactionId, it->functionCode, code, it->handler, it->frame_handler, it->pdu_handler);
+    }
+}
@@ -0,0 +1,203 @@
+#ifndef _MODBUS_CLIENT_H
+#define _MODBUS_CLIENT_H
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+#include <tr1/functional>
+#include <EventRouter.h>
+#include <Reactor.h>
+#include "Modbus.h"
+#include "ModbusFrame.h"
+#include "ModbusPdu.h"
+
+namespace j2 {
+
+    /** @brief Default number of requests a @c ModbusClient keeps in flight. */
+    const std::size_t DEFAULT_MODBUS_PIPELINE = 8;
+
+    /** @brief Default time a @c ModbusClient waits for a response. */
+    const boost::chrono::milliseconds DEFAULT_MODBUS_TIMEOUT(1000);
+
+    /** @brief Counts of the traffic of a @c ModbusClient. */
+    struct ModbusClientStats {
+        ModbusClientStats() : requests(0), responses(0), timeouts(0), failures(0), unmatched(0) { }
+
+        std::size_t requests;       ///< Requests sent
+        std::size_t responses;      ///< Responses matched to a request
+        std::size_t timeouts;       ///< Requests failed by @c expire
+        std::size_t failures;       ///< Requests failed because the connection closed
+        std::size_t unmatched;      ///< Responses undecodable or for no outstanding request
+    };
+
+    /**
+     * @brief Non-blocking Modbus TCP client that pipelines requests.
+     *
+     * Up to @c pipeline requests are sent without waiting for the responses
+     * before them, each with its own transaction id, and responses are
+     * matched to their requests by that id in whatever order they arrive.
+     * Further requests queue until a response frees a slot, so a link with
+     * a long round trip carries several polls per round trip rather than one.
+     * Requests the socket cannot take at once are sent as it becomes writable.
+     *
+     * The socket is watched by a @c Reactor and handlers run on the thread
+     * calling its @c wait.  Every handler is called exactly once: with the
+     * response, or with a locally made exception response carrying
+     * @c GatewayTargetFailedToRespond if the request timed out or
+     * @c GatewayPathUnavailable if the connection closed first.  Destroying
+     * the client drops outstanding requests without calling their handlers.
+     * All members must be called from the reactor's thread.
+     *
+     * Outstanding requests are held in a table of @c pipeline slots made
+     * with the client, so with @c request_pdu polling allocates nothing
+     * once the buffers have grown to the traffic, other than for requests
+     * queued beyond the pipeline.
+     */
+    class ModbusClient {
+    public:
+        typedef std::tr1::function<void (const ModbusTcpMessage&)> Handler;
+
+        /** @brief Called with a response frame, valid only during the call. */
+        typedef std::tr1::function<void (const ModbusFrame&)> FrameHandler;
+
+        /** @brief Called with a response decoded into a PDU, valid only during the call. */
+        typedef std::tr1::function<void (uint16_t transactionId, const ModbusPdu& response)> PduHandler;
+
+        /**
+         * @param reactor reactor watching the connection
+         * @param unitId unit addressed by requests
+         * @param pipeline most requests outstanding at once
+         * @param timeout time after which @c expire fails a request
+         */
+        explicit ModbusClient(Reactor& reactor,
+                              uint8_t unitId = 1,
+                              std::size_t pipeline = DEFAULT_MODBUS_PIPELINE,
+                              EventClock::duration timeout = DEFAULT_MODBUS_TIMEOUT);
+
+        ~ModbusClient();
+
+        /**
+         * @brief Connect to a server.  Connecting blocks, but the connection
+         * is non-blocking once made.
+         * @throws ModbusException if the connection cannot be made
+         */
+        void connect(const std::string& host, uint16_t port);
+
+        /** @brief Close the connection, failing every request not yet answered. */
+        void close();
+
+        bool is_connected() const { return _fd >= 0; }
+
+        /**
+         * @brief Send a request, or queue it until fewer than @c pipeline
+         * requests are outstanding, and call @c handler with its response.
+         * @return transaction id of the request
+         */
+        uint16_t request(const ModbusRequest& request, Handler handler) {
+            return enqueue(request, handler, FrameHandler());
+        }
+
+        /**
+         * @brief As @c request, but calls @c handler with the response
+         * parsed in place in the receive buffer, so that reading a response
+         * needs no allocation or copy.
+         */
+        uint16_t request_frame(const ModbusRequest& request, FrameHandler handler) {
+            return enqueue(request, Handler(), handler);
+        }
+
+        /**
+         * @brief As @c request, but with the request and response held in
+         * @c ModbusPdu.  While the pipeline has room the request is written
+         * straight into the send buffer, and the response is decoded into a
+         * PDU the client reuses, so with a handler that is a function pointer
+         * or otherwise fits a @c tr1::function without allocating, a request
+         * and its response allocate nothing.
+         */
+        uint16_t request_pdu(const ModbusPdu& request, PduHandler handler);
+
+        /**
+         * @brief Fail requests sent more than the timeout before @c now.
+         * Call periodically, for instance from a timer.
+         * @return number of requests failed
+         */
+        std::size_t expire(EventClock::time_point now = EventClock::now());
+
+        /** @brief Number of requests sent and not yet answered. */
+        std::size_t outstanding() const { return _outstanding; }
+
+        /** @brief Number of requests waiting for a slot in the pipeline. */
+        std::size_t queued() const { return _queue.size(); }
+
+        ModbusClientStats stats() const { return _stats; }
+
+    private:
+        // Each request has one of a handler, a frame handler or a PDU handler
+        struct Queued {
+            uint16_t transactionId;
+            uint8_t functionCode;
+            buffer frame;
+            Handler handler;
+            FrameHandler frame_handler;
+            PduHandler pdu_handler;
+        };
+
+        // A slot of the pending table, in use while active
+        struct Pending {
+            Pending() : active(false), transactionId(0), functionCode(0) { }
+
+            bool active;
+            uint16_t transactionId;
+            uint8_t functionCode;
+            EventClock::time_point sent;
+            Handler handler;
+            FrameHandler frame_handler;
+            PduHandler pdu_handler;
+        };
+
+        uint16_t enqueue(const ModbusRequest& request, Handler handler, FrameHandler frame_handler);
+        uint16_t next_transaction_id();
+        Pending* find_pending(uint16_t transactionId);
+        Pending& start(uint16_t transactionId, uint8_t functionCode, EventClock::time_point now);
+        void finish(Pending& pending);
+        void send_queued();
+        void flush();
+        void ready();
+        void fail(uint16_t transactionId, uint8_t functionCode, ModbusExceptionCode code,
+                  const Handler& handler, const FrameHandler& frame_handler,
+                  const PduHandler& pdu_handler);
+        void fail_all(ModbusExceptionCode code);
+
+        // Not copyable
+        ModbusClient(const ModbusClient&);
+        ModbusClient& operator=(const ModbusClient&);
+
+        Reactor& _reactor;
+        int _fd;
+        bool _writing;
+        const uint8_t _unitId;
+        const std::size_t _pipeline;
+        const EventClock::duration _timeout;
+        uint16_t _next_id;
+        std::vector<Pending> _pending;
+        std::size_t _outstanding;
+        std::deque<Queued> _queue;
+        buffer _input;
+        shared_buffer _output;
+        ModbusPdu _response;
+        ModbusClientStats _stats;
+    };
+
+    /** @brief Response handler publishing the response on a topic. */
+    struct PUBLISH_RESPONSE {
+        PUBLISH_RESPONSE(EventRouter& router, const std::string& topic) :
+            channel(router.channel<ModbusTcpMessage>(topic)) { }
+        void operator()(const ModbusTcpMessage& response) const { channel.publish(response); }
+        Channel<ModbusTcpMessage> channel;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_CLIENT_H
@@ -0,0 +1,154 @@
+#ifndef _MODBUS_FRAME_H
+#define _MODBUS_FRAME_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+#include "Io.h"
+#include "ModbusTcpMessage.h"
+
+namespace j2 {
+
+    /**
+     * @brief Registers held big endian in borrowed bytes, converted to host
+     * order only as each is read.
+     */
+    class RegisterView {
+    public:
+        RegisterView() { }
+
+        explicit RegisterView(ByteSpan bytes) : _bytes(bytes) { }
+
+        std::size_t size() const { return _bytes.size() / 2; }
+
+        bool empty() const { return size() == 0; }
+
+        uint16_t operator[](std::size_t i) const { return _bytes.uint16_at(2 * i); }
+
+        /** @brief Append the registers, in host order, to @c registers. */
+        void copy_to(std::vector<uint16_t>& registers) const {
+            registers.reserve(registers.size() + size());
+            for (std::size_t i = 0; i < size(); i++) registers.push_back((*this)[i]);
+        }
+
+        ByteSpan bytes() const { return _bytes; }
+
+    private:
+        ByteSpan _bytes;
+    };
+
+    /**
+     * @brief Modbus TCP frame decoded in place from borrowed bytes.
+     *
+     * Unlike @c ModbusTcpMessage, parsing a frame neither allocates nor
+     * copies: the header fields are read out and @c data refers to the
+     * bytes after the function code, which the views below interpret.  The
+     * frame is only valid while the bytes it was parsed from are.
+     */
+    class ModbusFrame {
+    public:
+        enum Status {
+            Incomplete,     ///< More bytes are needed for a whole frame
+            Invalid,        ///< The bytes cannot be the start of a frame
+            Complete        ///< A frame was parsed
+        };
+
+        ModbusFrame() : transactionId(0), protocolId(0), size(0), unitId(0), functionCode(0) { }
+
+        /**
+         * @brief Parse the frame at the start of @c bytes.
+         * @c frame_size() bytes are used when the frame is complete.
+         */
+        Status parse(ByteSpan bytes) {
+            if (bytes.size() < MODBUS_TCP_PREFIX) return Incomplete;
+            transactionId = bytes.uint16_at(0);
+            protocolId = bytes.uint16_at(2);
+            size = bytes.uint16_at(4);
+            if (protocolId != 0 || size < 2 || frame_size() > MODBUS_TCP_MAX_FRAME) return Invalid;
+            if (bytes.size() < frame_size()) return Incomplete;
+            unitId = bytes[6];
+            functionCode = bytes[7];
+            data = bytes.subspan(MODBUS_TCP_PREFIX + 2, size - 2);
+            return Complete;
+        }
+
+        /** @brief Bytes taken by the whole frame. */
+        std::size_t frame_size() const { return MODBUS_TCP_PREFIX + size; }
+
+        /** @brief Whether the frame is an exception response */
+        bool isException() const { return (functionCode & MODBUS_EXCEPTION_FLAG) != 0; }
+
+        /** @brief Exception code of an exception response, or 0 if malformed. */
+        uint8_t exception() const { return data.empty() ? 0 : data[0]; }
+
+    public:
+        uint16_t transactionId;       // Unique transaction id
+        uint16_t protocolId;          // Must be zero for Modbus TCP
+        uint16_t size;                // Bytes after the size field
+        uint8_t unitId;               // Unit id
+        uint8_t functionCode;         // Function
+        ByteSpan data;                // Bytes after the function code
+    };
+
+    /** @brief View of a @c ReadHoldingRegistersRequest. */
+    struct ReadHoldingRegistersRequestView {
+        /** @return false if the frame is not a well formed request */
+        bool parse(const ModbusFrame& frame) {
+            if (frame.functionCode != ReadHoldingRegisters || frame.data.size() != 4) return false;
+            startingAddress = frame.data.uint16_at(0);
+            numberOfRegisters = frame.data.uint16_at(2);
+            return true;
+        }
+
+        uint16_t startingAddress;
+        uint16_t numberOfRegisters;
+    };
+
+    /** @brief View of a @c ReadHoldingRegistersResponse. */
+    struct ReadHoldingRegistersResponseView {
+        /** @return false if the frame is not a well formed response */
+        bool parse(const ModbusFrame& frame) {
+            if (frame.functionCode != ReadHoldingRegisters || frame.data.empty()) return false;
+            std::size_t nrBytes = frame.data[0];
+            if (nrBytes % 2 != 0 || frame.data.size() != nrBytes + 1) return false;
+            registers = RegisterView(frame.data.subspan(1, nrBytes));
+            return true;
+        }
+
+        RegisterView registers;
+    };
+
+    /** @brief View of a @c WriteMultipleRegistersRequest. */
+    struct WriteMultipleRegistersRequestView {
+        /** @return false if the frame is not a well formed request */
+        bool parse(const ModbusFrame& frame) {
+            if (frame.functionCode != WriteMultipleRegisters || frame.data.size() < 5) return false;
+            starting_address = frame.data.uint16_at(0);
+            std::size_t nrRegisters = frame.data.uint16_at(2);
+            std::size_t nrBytes = frame.data[4];
+            if (nrBytes != nrRegisters * 2 || frame.data.size() != nrBytes + 5) return false;
+            registers = RegisterView(frame.data.subspan(5, nrBytes));
+            return true;
+        }
+
+        uint16_t starting_address;
+        RegisterView registers;
+    };
+
+    /** @brief View of a @c WriteMultipleRegistersResponse. */
+    struct WriteMultipleRegistersResponseView {
+        /** @return false if the frame is not a well formed response */
+        bool parse(const ModbusFrame& frame) {
+            if (frame.functionCode != WriteMultipleRegisters || frame.data.size() != 4) return false;
+            startingAddress = frame.data.uint16_at(0);
+            numberOfRegisters = frame.data.uint16_at(2);
+            return true;
+        }
+
+        uint16_t startingAddress;
+        uint16_t numberOfRegisters;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_FRAME_H
@@ -0,0 +1,131 @@
+#include <deque>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <boost/bind.hpp>
+#include <boost/chrono/ceil.hpp>
+#include "ModbusLoopbackServer.h"
+
+using namespace j2;
+
+namespace {
+    const int POLL_INTERVAL_MS = 10;
+
+    // Latency is real time, even when the clock is simulated
+    typedef boost::chrono::steady_clock LinkClock;
+
+    void throw_errno(const char* what) {
+        throw ModbusException(std::string(what) + ": " + strerror(errno));
+    }
+}
+
+ModbusLoopbackServer::ModbusLoopbackServer(std::size_t registers, EventClock::duration latency) :
+    _listener(-1),
+    _port(0),
+    _latency(latency),
+    _image(registers),
+    _stopped(false),
+    _silent(false),
+    _disconnect(false),
+    _hang_up(false),
+    _reverse_batch(0),
+    _requests(0) {
+    for (std::size_t i = 0; i < registers; i++) _image.set(i, uint16_t(i));
+
+    _listener = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (_listener < 0) throw_errno("socket");
+    int one = 1;
+    setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (bind(_listener, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+        listen(_listener, 4) < 0 ||
+        getsockname(_listener, (struct sockaddr*)&address, &length) < 0) {
+        int error = errno;
+        close(_listener);
+        errno = error;
+        throw_errno("listen");
+    }
+    _port = ntohs(address.sin_port);
+    _thread = boost::thread(boost::bind(&ModbusLoopbackServer::run, this));
+}
+
+ModbusLoopbackServer::~ModbusLoopbackServer() {
+    _stopped.store(true);
+    _thread.join();
+    close(_listener);
+}
+
+void ModbusLoopbackServer::run() {
+    while (!_stopped.load()) {
+        struct pollfd listener;
+        listener.fd = _listener;
+        listener.events = POLLIN;
+        if (poll(&listener, 1, POLL_INTERVAL_MS) <= 0) continue;
+        int connection = accept4(_listener, 0, 0, SOCK_CLOEXEC);
+        if (connection < 0) continue;
+        serve(connection);
+        close(connection);
+    }
+}
+
+void ModbusLoopbackServer::serve(int connection) {
+    buffer input;
+    std::vector<Reply> held;
+    std::deque<Reply> replies;
+    while (!_stopped.load() && !_disconnect.exchange(false)) {
+        int timeout = POLL_INTERVAL_MS;
+        if (!replies.empty()) {
+            LinkClock::duration wait = replies.front().due - LinkClock::now();
+            timeout = std::min(timeout, std::max(0, int(boost::chrono::ceil<boost::chrono::milliseconds>(wait).count())));
+        }
+        struct pollfd client;
+        client.fd = connection;
+        client.events = POLLIN;
+        client.revents = 0;
+        if (poll(&client, 1, timeout) > 0 && (client.revents & (POLLIN | POLLHUP | POLLERR))) {
+            uint8_t chunk[4096];
+            ssize_t got = recv(connection, chunk, sizeof(chunk), 0);
+            if (got <= 0 && !(got < 0 && errno == EINTR)) return;
+            if (got > 0) input.insert(input.end(), chunk, chunk + got);
+        }
+
+        ByteSpan unparsed(input);
+        ModbusFrame frame;
+        ModbusFrame::Status status;
+        while ((status = frame.parse(unparsed)) == ModbusFrame::Complete) {
+            unparsed = unparsed.subspan(frame.frame_size());
+            _requests++;
+            if (_silent.load()) continue;
+
+            held.push_back(Reply());
+            held.back().due = LinkClock::now() + _latency;
+            shared_buffer reply(new buffer);
+            MemoryIoWriter writer(reply);
+            ModbusServer::respond(_image, frame, writer);
+            held.back().frame.swap(*reply);
+            if (held.size() >= std::max<std::size_t>(_reverse_batch.load(), 1)) {
+                replies.insert(replies.end(), held.rbegin(), held.rend());
+                held.clear();
+            }
+        }
+        if (status == ModbusFrame::Invalid) return;
+        input.erase(input.begin(), input.end() - unparsed.size());
+
+        while (!replies.empty() && replies.front().due <= LinkClock::now()) {
+            const buffer& frame = replies.front().frame;
+            if (send(connection, &frame[0], frame.size(), MSG_NOSIGNAL) < 0) return;
+            replies.pop_front();
+            if (replies.empty() && held.empty() && _hang_up.load()) return;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef _MODBUS_LOOPBACK_SERVER_H
+#define _MODBUS_LOOPBACK_SERVER_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <EventRouter.h>
+#include "ModbusServer.h"
+
+namespace j2 {
+
+    /**
+     * @brief Stand-in for a PLC on the loopback interface, for testing and
+     * benchmarking Modbus clients without one.
+     *
+     * Serves holding registers from a register image, as @c ModbusServer
+     * does, but on its own thread and one connection at a time.  Each
+     * response is held back by the configured latency, as over a slow link,
+     * but requests keep being read meanwhile, so pipelined requests overlap
+     * as they would with a real PLC that answers in turn.
+     */
+    class ModbusLoopbackServer {
+    public:
+        /**
+         * @param registers size of the register image; register @c i starts as @c i
+         * @param latency delay before each response is sent
+         * @throws ModbusException if the listening socket cannot be made
+         */
+        explicit ModbusLoopbackServer(std::size_t registers = 1024,
+                                      EventClock::duration latency = EventClock::duration::zero());
+
+        ~ModbusLoopbackServer();
+
+        /** @brief Port listened on, chosen by the system. */
+        uint16_t port() const { return _port; }
+
+        /** @brief Stop answering requests, to make clients time out. */
+        void set_silent(bool silent) { _silent.store(silent); }
+
+        /**
+         * @brief Hold responses until @c count are ready, then send them
+         * newest first, to check that clients match them by transaction id.
+         */
+        void set_reverse_batch(std::size_t count) { _reverse_batch.store(count); }
+
+        /**
+         * @brief Close each connection as soon as its responses have been
+         * sent, so that clients receive the last response and the close together.
+         */
+        void set_hang_up(bool hang_up) { _hang_up.store(hang_up); }
+
+        /** @brief Close the current or next connection, as a PLC restarting would. */
+        void disconnect() { _disconnect.store(true); }
+
+        /** @brief Registers served. */
+        ModbusRegisterImage& image() { return _image; }
+
+        /** @brief Number of requests received. */
+        std::size_t requests() const { return _requests.load(); }
+
+    private:
+        struct Reply {
+            EventClock::time_point due;
+            buffer frame;
+        };
+
+        void run();
+        void serve(int connection);
+
+        // Not copyable
+        ModbusLoopbackServer(const ModbusLoopbackServer&);
+        ModbusLoopbackServer& operator=(const ModbusLoopbackServer&);
+
+        int _listener;
+        uint16_t _port;
+        const EventClock::duration _latency;
+        ModbusRegisterImage _image;
+        boost::atomic<bool> _stopped;
+        boost::atomic<bool> _silent;
+        boost::atomic<bool> _disconnect;
+        boost::atomic<bool> _hang_up;
+        boost::atomic<std::size_t> _reverse_batch;
+        boost::atomic<std::size_t> _requests;
+        boost::thread _thread;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_LOOPBACK_SERVER_H
@@ -1,3 +1,4 @@
+#include <stdexcept>
 #include "Io.h"
 
 #ifndef _MODBUS_MESSAGE_H
@@ -12,14 +13,24 @@ namespace j2 {
         ReportSlaveId = 17        
     };
 
+    /** @brief Bit set in the function code of an exception response */
+    const uint8_t MODBUS_EXCEPTION_FLAG = 0x80;
+
     enum ModbusExceptionCode {
         IllegalFunction = 0x1,
         IllegalDataAddress = 0x2,
         IllegalDataValue = 0x3,
-        SlaveDeviceFailure = 0x4
+        SlaveDeviceFailure = 0x4,
+        GatewayPathUnavailable = 0xA,
+        GatewayTargetFailedToRespond = 0xB
     };
         
         
+    class ModbusException: public std::runtime_error {
+    public:
+        explicit ModbusException(const std::string &err) : runtime_error(err) {}
+    };
+
     class ModbusRequest;
     class ModbusResponse;
 
@@ -28,6 +39,9 @@ namespace j2 {
         static ModbusRequest* request_for(ModbusFunctionCode code);
         static ModbusResponse* response_for(ModbusFunctionCode code);
     public:
+        // Messages are deleted through this class by ModbusTcpMessage
+        virtual ~ModbusMessage() { }
+
         virtual ModbusFunctionCode functionCode() const = 0;
         
         virtual int size() const = 0;
@@ -81,22 +95,23 @@ namespace j2 {
         ModbusFunctionCode functionCode() const { return ReadHoldingRegisters; }
 
         int size() const { 
-            return sizeof(uint16_t) +
+            return sizeof(uint8_t) +
                 (registers.size() * sizeof(uint16_t)); }
 
 
         void serialize(IoWriter& writer) const {
+            assert(registers.size() < 128);
             writer
-                .write(uint16_t(registers.size())) 
+                .write(uint8_t(registers.size() * 2)) 
                 .write(registers);                   
         }
 
         void deserialize(IoReader& reader) {
             registers.clear();
-            uint16_t nrRegisters;
-            reader.read(&nrRegisters);
-            reader.buffer(nrRegisters * 2);
-            reader.read(registers, nrRegisters);
+            uint8_t nrBytes;
+            reader.read(&nrBytes);
+            reader.buffer(nrBytes);
+            reader.read(registers, nrBytes / 2);
         }
 
     public:
@@ -111,20 +126,18 @@ namespace j2 {
             _function_code(function_code),
             _exception(exception) { }
 
-        int size() const { return sizeof(_function_code) + sizeof(_exception); }
+        // The function code travels in the message header, so only the
+        // exception code is part of the body
+        int size() const { return sizeof(_exception); }
 
         ModbusFunctionCode functionCode() const { return (ModbusFunctionCode) _function_code; }
 
         void serialize(IoWriter& writer) const {
-            writer
-                .write(_function_code)
-                .write(_exception);
+            writer.write(_exception);
         }
 
         void deserialize(IoReader& reader) {
-            reader
-                .read(&_function_code)
-                .read(&_exception);
+            reader.read(&_exception);
         }
 
         uint8_t exception() const { return _exception; }
@@ -170,7 +183,10 @@ namespace j2 {
             reader.read(&starting_address);
             reader.read(&nrRegisters);
             reader.read(&nrBytes);
-            assert(nrBytes == nrRegisters * 2);
+            if (nrBytes != nrRegisters * 2) {
+                reader.error(ModbusException("Invalid byte count"));
+                return;
+            }
             reader.buffer(nrBytes);
             reader.read(registers, nrRegisters);
         }
@@ -216,7 +232,7 @@ namespace j2 {
         switch(code) {
         case ReadHoldingRegisters: return new ReadHoldingRegistersRequest;
         case WriteMultipleRegisters: return new WriteMultipleRegistersRequest;
-        default: return new ModbusExceptionMessage(0x80 & code, IllegalFunction);
+        default: return new ModbusExceptionMessage(MODBUS_EXCEPTION_FLAG | code, IllegalFunction);
         }
     }
         
@@ -224,7 +240,7 @@ namespace j2 {
         switch(code) {
         case ReadHoldingRegisters: return new ReadHoldingRegistersResponse;
         case WriteMultipleRegisters: return new WriteMultipleRegistersResponse;
-        default: return new ModbusExceptionMessage(0x80 & code, IllegalFunction);
+        default: return new ModbusExceptionMessage(MODBUS_EXCEPTION_FLAG | code, IllegalFunction);
         }
     }
 
@@ -0,0 +1,271 @@
+#ifndef _MODBUS_PDU_H
+#define _MODBUS_PDU_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <assert.h>
+#include "Io.h"
+#include "ModbusMessage.h"
+#include "ModbusFrame.h"
+
+namespace j2 {
+
+    /** @brief Most registers a @c ReadHoldingRegisters request may ask for. */
+    const std::size_t MODBUS_MAX_READ_REGISTERS = 125;
+
+    /** @brief Most registers a @c WriteMultipleRegisters request may carry. */
+    const std::size_t MODBUS_MAX_WRITE_REGISTERS = 123;
+
+    /**
+     * @brief Any supported Modbus request or response, held inline.
+     *
+     * The allocation free counterpart of @c ModbusMessage: rather than a
+     * heap allocated subclass found with @c dynamic_cast, the message is
+     * one member of a union, told apart by @c kind(), and registers are
+     * held in fixed arrays sized for the largest message the protocol
+     * allows.  A PDU is reused from frame to frame by decoding or making
+     * another message in it, so steady traffic allocates nothing.
+     */
+    class ModbusPdu {
+    public:
+        enum Kind {
+            Empty,                              ///< No message, or decoding failed
+            ReadHoldingRegistersRequestPdu,
+            ReadHoldingRegistersResponsePdu,
+            WriteMultipleRegistersRequestPdu,
+            WriteMultipleRegistersResponsePdu,
+            ExceptionPdu
+        };
+
+        struct ReadRequest {
+            uint16_t startingAddress;
+            uint16_t numberOfRegisters;
+        };
+
+        struct ReadResponse {
+            uint16_t numberOfRegisters;
+            uint16_t registers[MODBUS_MAX_READ_REGISTERS];
+        };
+
+        struct WriteRequest {
+            uint16_t startingAddress;
+            uint16_t numberOfRegisters;
+            uint16_t registers[MODBUS_MAX_WRITE_REGISTERS];
+        };
+
+        struct WriteResponse {
+            uint16_t startingAddress;
+            uint16_t numberOfRegisters;
+        };
+
+        struct Exception {
+            uint8_t functionCode;               ///< Function code, with @c MODBUS_EXCEPTION_FLAG set
+            uint8_t exception;                  ///< A @c ModbusExceptionCode
+        };
+
+        ModbusPdu() : _kind(Empty) { }
+
+        Kind kind() const { return _kind; }
+
+        /** @brief Function code sent in the frame, or @c InvalidFunction if empty. */
+        uint8_t functionCode() const {
+            switch (_kind) {
+            case ReadHoldingRegistersRequestPdu:
+            case ReadHoldingRegistersResponsePdu: return ReadHoldingRegisters;
+            case WriteMultipleRegistersRequestPdu:
+            case WriteMultipleRegistersResponsePdu: return WriteMultipleRegisters;
+            case ExceptionPdu: return _pdu.exception.functionCode;
+            case Empty: break;
+            }
+            return InvalidFunction;
+        }
+
+        /** @brief Bytes after the function code, as for @c ModbusMessage::size. */
+        std::size_t size() const {
+            switch (_kind) {
+            case ReadHoldingRegistersRequestPdu: return 4;
+            case ReadHoldingRegistersResponsePdu: return 1 + 2 * _pdu.read_response.numberOfRegisters;
+            case WriteMultipleRegistersRequestPdu: return 5 + 2 * _pdu.write_request.numberOfRegisters;
+            case WriteMultipleRegistersResponsePdu: return 4;
+            case ExceptionPdu: return 1;
+            case Empty: break;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Decode the request carried by @c frame.
+         * @return false, leaving the PDU empty, if the function is not
+         * supported or the request is malformed
+         */
+        bool decode_request(const ModbusFrame& frame) {
+            _kind = Empty;
+            switch (frame.functionCode) {
+            case ReadHoldingRegisters: {
+                ReadHoldingRegistersRequestView view;
+                if (!view.parse(frame)) return false;
+                ReadRequest& request = make_read_request();
+                request.startingAddress = view.startingAddress;
+                request.numberOfRegisters = view.numberOfRegisters;
+                return true;
+            }
+            case WriteMultipleRegisters: {
+                WriteMultipleRegistersRequestView view;
+                if (!view.parse(frame) || view.registers.size() > MODBUS_MAX_WRITE_REGISTERS) return false;
+                WriteRequest& request = make_write_request();
+                request.startingAddress = view.starting_address;
+                request.numberOfRegisters = uint16_t(view.registers.size());
+                copy_registers(view.registers, request.registers);
+                return true;
+            }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Decode the response, or exception response, carried by @c frame.
+         * @return false, leaving the PDU empty, if the function is not
+         * supported or the response is malformed
+         */
+        bool decode_response(const ModbusFrame& frame) {
+            _kind = Empty;
+            if (frame.isException()) {
+                if (frame.data.size() != 1) return false;
+                make_exception(frame.functionCode, ModbusExceptionCode(frame.exception()));
+                return true;
+            }
+            switch (frame.functionCode) {
+            case ReadHoldingRegisters: {
+                ReadHoldingRegistersResponseView view;
+                if (!view.parse(frame) || view.registers.size() > MODBUS_MAX_READ_REGISTERS) return false;
+                ReadResponse& response = make_read_response();
+                response.numberOfRegisters = uint16_t(view.registers.size());
+                copy_registers(view.registers, response.registers);
+                return true;
+            }
+            case WriteMultipleRegisters: {
+                WriteMultipleRegistersResponseView view;
+                if (!view.parse(frame)) return false;
+                WriteResponse& response = make_write_response();
+                response.startingAddress = view.startingAddress;
+                response.numberOfRegisters = view.numberOfRegisters;
+                return true;
+            }
+            }
+            return false;
+        }
+
+        /** @brief Write the message as a Modbus TCP frame. */
+        void write(IoWriter& writer, uint16_t transactionId, uint8_t unitId) const {
+            assert(_kind != Empty);
+            writer
+                .write(transactionId)
+                .write(uint16_t(0))
+                .write(uint16_t(size() + sizeof(unitId) + sizeof(uint8_t)))
+                .write(unitId)
+                .write(functionCode());
+            switch (_kind) {
+            case ReadHoldingRegistersRequestPdu:
+                writer
+                    .write(_pdu.read_request.startingAddress)
+                    .write(_pdu.read_request.numberOfRegisters);
+                break;
+            case ReadHoldingRegistersResponsePdu:
+                writer
+                    .write(uint8_t(_pdu.read_response.numberOfRegisters * 2))
+                    .write(_pdu.read_response.registers, _pdu.read_response.numberOfRegisters);
+                break;
+            case WriteMultipleRegistersRequestPdu:
+                writer
+                    .write(_pdu.write_request.startingAddress)
+                    .write(_pdu.write_request.numberOfRegisters)
+                    .write(uint8_t(_pdu.write_request.numberOfRegisters * 2))
+                    .write(_pdu.write_request.registers, _pdu.write_request.numberOfRegisters);
+                break;
+            case WriteMultipleRegistersResponsePdu:
+                writer
+                    .write(_pdu.write_response.startingAddress)
+                    .write(_pdu.write_response.numberOfRegisters);
+                break;
+            case ExceptionPdu:
+                writer.write(_pdu.exception.exception);
+                break;
+            case Empty:
+                break;
+            }
+        }
+
+        /** @brief Hold a read request, returned for filling in. */
+        ReadRequest& make_read_request() {
+            _kind = ReadHoldingRegistersRequestPdu;
+            return _pdu.read_request;
+        }
+
+        /** @brief Hold a read response, returned for filling in. */
+        ReadResponse& make_read_response() {
+            _kind = ReadHoldingRegistersResponsePdu;
+            return _pdu.read_response;
+        }
+
+        /** @brief Hold a write request, returned for filling in. */
+        WriteRequest& make_write_request() {
+            _kind = WriteMultipleRegistersRequestPdu;
+            return _pdu.write_request;
+        }
+
+        /** @brief Hold a write response, returned for filling in. */
+        WriteResponse& make_write_response() {
+            _kind = WriteMultipleRegistersResponsePdu;
+            return _pdu.write_response;
+        }
+
+        /** @brief Hold the exception response to a request for @c function. */
+        void make_exception(uint8_t function, ModbusExceptionCode exception) {
+            _kind = ExceptionPdu;
+            _pdu.exception.functionCode = uint8_t(function | MODBUS_EXCEPTION_FLAG);
+            _pdu.exception.exception = uint8_t(exception);
+        }
+
+        const ReadRequest& read_request() const {
+            assert(_kind == ReadHoldingRegistersRequestPdu);
+            return _pdu.read_request;
+        }
+
+        const ReadResponse& read_response() const {
+            assert(_kind == ReadHoldingRegistersResponsePdu);
+            return _pdu.read_response;
+        }
+
+        const WriteRequest& write_request() const {
+            assert(_kind == WriteMultipleRegistersRequestPdu);
+            return _pdu.write_request;
+        }
+
+        const WriteResponse& write_response() const {
+            assert(_kind == WriteMultipleRegistersResponsePdu);
+            return _pdu.write_response;
+        }
+
+        const Exception& exception() const {
+            assert(_kind == ExceptionPdu);
+            return _pdu.exception;
+        }
+
+    private:
+        static void copy_registers(const RegisterView& view, uint16_t* registers) {
+            for (std::size_t i = 0; i < view.size(); i++) registers[i] = view[i];
+        }
+
+        Kind _kind;
+        union {
+            ReadRequest read_request;
+            ReadResponse read_response;
+            WriteRequest write_request;
+            WriteResponse write_response;
+            Exception exception;
+        } _pdu;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_PDU_H
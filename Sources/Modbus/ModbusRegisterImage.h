@@ -0,0 +1,219 @@
+#ifndef _MODBUS_REGISTER_IMAGE_H
+#define _MODBUS_REGISTER_IMAGE_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <boost/thread/mutex.hpp>
+#include <Module.h>
+#include <Timestamp.h>
+
+namespace j2 {
+
+    /** @brief Number of holding registers addressable by Modbus. */
+    const std::size_t MODBUS_REGISTERS = 65536;
+
+    /**
+     * @brief How a value is laid out in holding registers.
+     *
+     * Values wider than a register are stored most significant word first,
+     * and floating point values as 32-bit IEEE reals, which is what most
+     * SCADA and HMI clients read.  Specialise for other types, such as a
+     * struct of several values, to publish them in a register image.
+     */
+    template <typename T> struct RegisterCodec;
+
+    template <> struct RegisterCodec<uint16_t> {
+        static const std::size_t COUNT = 1;
+        static void encode(uint16_t value, uint16_t* registers) { registers[0] = value; }
+        static uint16_t decode(const uint16_t* registers) { return registers[0]; }
+    };
+
+    template <> struct RegisterCodec<int16_t> {
+        static const std::size_t COUNT = 1;
+        static void encode(int16_t value, uint16_t* registers) { registers[0] = uint16_t(value); }
+        static int16_t decode(const uint16_t* registers) { return int16_t(registers[0]); }
+    };
+
+    template <> struct RegisterCodec<uint32_t> {
+        static const std::size_t COUNT = 2;
+        static void encode(uint32_t value, uint16_t* registers) {
+            registers[0] = uint16_t(value >> 16);
+            registers[1] = uint16_t(value & 0xffff);
+        }
+        static uint32_t decode(const uint16_t* registers) {
+            return (uint32_t(registers[0]) << 16) | registers[1];
+        }
+    };
+
+    template <> struct RegisterCodec<int32_t> {
+        static const std::size_t COUNT = 2;
+        static void encode(int32_t value, uint16_t* registers) {
+            RegisterCodec<uint32_t>::encode(uint32_t(value), registers);
+        }
+        static int32_t decode(const uint16_t* registers) {
+            return int32_t(RegisterCodec<uint32_t>::decode(registers));
+        }
+    };
+
+    template <> struct RegisterCodec<float> {
+        static const std::size_t COUNT = 2;
+        static void encode(float value, uint16_t* registers) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            RegisterCodec<uint32_t>::encode(bits, registers);
+        }
+        static float decode(const uint16_t* registers) {
+            uint32_t bits = RegisterCodec<uint32_t>::decode(registers);
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+    template <> struct RegisterCodec<double> {
+        static const std::size_t COUNT = 2;
+        static void encode(double value, uint16_t* registers) {
+            RegisterCodec<float>::encode(float(value), registers);
+        }
+        static double decode(const uint16_t* registers) {
+            return RegisterCodec<float>::decode(registers);
+        }
+    };
+
+    /** @brief A timestamped value is stored as its value. */
+    template <typename T> struct RegisterCodec< Timestamped<T> > {
+        static const std::size_t COUNT = RegisterCodec<T>::COUNT;
+        static void encode(const Timestamped<T>& value, uint16_t* registers) {
+            RegisterCodec<T>::encode(value.value(), registers);
+        }
+    };
+
+    /**
+     * @brief Holding registers served by a @c ModbusServer.
+     *
+     * Every member may be called from any thread, and a block of registers
+     * is read and written as a whole, so a client never sees half of a
+     * value that spans several registers.
+     */
+    class ModbusRegisterImage {
+    public:
+        /** @param size number of registers, starting at address 0 */
+        explicit ModbusRegisterImage(std::size_t size = MODBUS_REGISTERS) : _registers(size) { }
+
+        std::size_t size() const { return _registers.size(); }
+
+        /**
+         * @brief Copy @c count registers from @c address onto the end of
+         * @c registers.
+         * @return false, copying nothing, if the block is outside the image
+         */
+        bool read(std::size_t address, std::size_t count, std::vector<uint16_t>& registers) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!contains(address, count)) return false;
+            registers.insert(registers.end(),
+                             _registers.begin() + address,
+                             _registers.begin() + address + count);
+            return true;
+        }
+
+        /**
+         * @brief Copy @c count registers from @c address into @c registers,
+         * which must have room for them.
+         * @return false, copying nothing, if the block is outside the image
+         */
+        bool read(std::size_t address, std::size_t count, uint16_t* registers) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!contains(address, count)) return false;
+            std::copy(_registers.begin() + address, _registers.begin() + address + count, registers);
+            return true;
+        }
+
+        /**
+         * @brief Overwrite registers from @c address.
+         * @return false, writing nothing, if the block is outside the image
+         */
+        bool write(std::size_t address, const std::vector<uint16_t>& registers) {
+            return write(address, registers.empty() ? 0 : &registers[0], registers.size());
+        }
+
+        /** @brief Overwrite @c count registers from @c address with @c registers. */
+        bool write(std::size_t address, const uint16_t* registers, std::size_t count) {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!contains(address, count)) return false;
+            std::copy(registers, registers + count, _registers.begin() + address);
+            return true;
+        }
+
+        /**
+         * @brief Store a value in the registers from @c address.
+         * @return false if the value does not fit in the image
+         */
+        template <typename T>
+        bool set(std::size_t address, const T& value) {
+            uint16_t registers[RegisterCodec<T>::COUNT];
+            RegisterCodec<T>::encode(value, registers);
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!contains(address, RegisterCodec<T>::COUNT)) return false;
+            std::copy(registers, registers + RegisterCodec<T>::COUNT, _registers.begin() + address);
+            return true;
+        }
+
+        /**
+         * @brief Value stored from @c address.
+         * @throws std::out_of_range if the value is outside the image
+         */
+        template <typename T>
+        T get(std::size_t address) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!contains(address, RegisterCodec<T>::COUNT)) throw std::out_of_range("register address");
+            return RegisterCodec<T>::decode(&_registers[address]);
+        }
+
+    private:
+        bool contains(std::size_t address, std::size_t count) const {
+            return address <= _registers.size() && count <= _registers.size() - address;
+        }
+
+        std::vector<uint16_t> _registers;
+        mutable boost::mutex _mutex;
+    };
+
+    /** @brief Store each value delivered to a typed signal in a register image. */
+    template <typename T> struct STORE_REGISTERS {
+        STORE_REGISTERS(ModbusRegisterImage* image, std::size_t address) :
+            image(image), address(address) { }
+        void operator()(const T& value) const { image->set(address, value); }
+        ModbusRegisterImage* image;
+        std::size_t address;
+    };
+
+    /**
+     * @brief Module keeping a register image up to date with topics, for
+     * a @c ModbusServer to serve.
+     */
+    class RegisterImageModule : public Module {
+    public:
+        RegisterImageModule(EventRouter* central=EventRouter::instance()) : Module(central) { }
+
+        RegisterImageModule(std::tr1::shared_ptr<EventRouter> central) : Module(central) { }
+
+        /** @brief Store the values published on @c topic in the registers from @c address. */
+        template <typename T>
+        void map(const std::string& topic, std::size_t address) {
+            bind_fn<T>(topic, STORE_REGISTERS<T>(&_image, address));
+        }
+
+        ModbusRegisterImage& image() { return _image; }
+
+    private:
+        ModbusRegisterImage _image;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_REGISTER_IMAGE_H
@@ -0,0 +1,217 @@
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include "ModbusServer.h"
+
+using namespace j2;
+
+namespace {
+    const std::size_t READ_CHUNK = 4096;
+
+    void throw_errno(const std::string& what) {
+        throw ModbusException(what + ": " + strerror(errno));
+    }
+
+    bool write_exception(const ModbusFrame& request, ModbusExceptionCode code, IoWriter& writer) {
+        ModbusPdu response;
+        response.make_exception(request.functionCode, code);
+        response.write(writer, request.transactionId, request.unitId);
+        return true;
+    }
+}
+
+const std::size_t ModbusServer::MAX_PENDING_OUTPUT;
+
+ModbusServer::ModbusServer(Reactor& reactor,
+                           ModbusRegisterImage& image,
+                           std::size_t max_connections) :
+    _reactor(reactor),
+    _image(image),
+    _max_connections(max_connections),
+    _listener(-1),
+    _port(0) { }
+
+ModbusServer::~ModbusServer() {
+    close();
+}
+
+void ModbusServer::listen(const std::string& address, uint16_t port) {
+    close();
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!address.empty() && inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1) {
+        throw ModbusException("Invalid address " + address);
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw_errno("socket");
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    socklen_t length = sizeof(local);
+    if (bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0 ||
+        getsockname(fd, (struct sockaddr*)&local, &length) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        throw_errno("Cannot listen on port " + boost::lexical_cast<std::string>(port));
+    }
+    _listener = fd;
+    _port = ntohs(local.sin_port);
+    _reactor.watch(_listener, boost::bind(&ModbusServer::accept, this));
+}
+
+void ModbusServer::close() {
+    while (!_connections.empty()) disconnect(_connections.begin()->first);
+    if (_listener >= 0) {
+        _reactor.unwatch(_listener);
+        ::close(_listener);
+        _listener = -1;
+        _port = 0;
+    }
+}
+
+void ModbusServer::accept() {
+    for (;;) {
+        int fd = accept4(_listener, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN once the backlog is empty; other errors, such as
+            // running out of descriptors, are retried when next readable
+            return;
+        }
+        if (_connections.size() >= _max_connections) {
+            ::close(fd);
+            _stats.rejected++;
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        _connections[fd].output.reset(new buffer);
+        _reactor.watch(fd, boost::bind(&ModbusServer::ready, this, fd));
+        _stats.accepted++;
+    }
+}
+
+void ModbusServer::ready(int fd) {
+    std::map<int, Connection>::iterator it = _connections.find(fd);
+    if (it == _connections.end()) return;
+    Connection& connection = it->second;
+
+    uint8_t chunk[READ_CHUNK];
+    for (;;) {
+        ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+        if (got > 0) {
+            connection.input.insert(connection.input.end(), chunk, chunk + got);
+            continue;
+        }
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        disconnect(fd);
+        return;
+    }
+
+    MemoryIoWriter writer(connection.output);
+    ByteSpan unparsed(connection.input);
+    for (;;) {
+        ModbusFrame frame;
+        ModbusFrame::Status status = frame.parse(unparsed);
+        if (status == ModbusFrame::Incomplete) break;
+        if (status == ModbusFrame::Invalid) {
+            // Framing is lost, so nothing after this can be trusted
+            disconnect(fd);
+            return;
+        }
+        unparsed = unparsed.subspan(frame.frame_size());
+        _stats.requests++;
+        if (respond(_image, frame, writer)) _stats.exceptions++;
+    }
+    connection.input.erase(connection.input.begin(), connection.input.end() - unparsed.size());
+
+    if (!flush(fd, connection)) {
+        disconnect(fd);
+        return;
+    }
+    // Only watch for writability while output is left, since an idle
+    // socket is always writable
+    bool writing = !connection.output->empty();
+    if (writing != connection.writing) {
+        int events = writing ? Reactor::Readable | Reactor::Writable : Reactor::Readable;
+        _reactor.watch(fd, boost::bind(&ModbusServer::ready, this, fd), events);
+        connection.writing = writing;
+    }
+}
+
+// A write only falls short when the client is slow to read, and what is
+// left is sent once the socket is writable again.
+bool ModbusServer::flush(int fd, Connection& connection) {
+    buffer& output = *connection.output;
+    std::size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t written = send(fd, &output[sent], output.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += std::size_t(written);
+    }
+    output.erase(output.begin(), output.begin() + sent);
+    return output.size() <= MAX_PENDING_OUTPUT;
+}
+
+void ModbusServer::disconnect(int fd) {
+    _reactor.unwatch(fd);
+    ::close(fd);
+    _connections.erase(fd);
+    _stats.closed++;
+}
+
+bool ModbusServer::respond(ModbusRegisterImage& image, const ModbusFrame& frame, IoWriter& writer) {
+    bool supported = frame.functionCode == ReadHoldingRegisters ||
+        frame.functionCode == WriteMultipleRegisters;
+    if (!supported) return write_exception(frame, IllegalFunction, writer);
+    ModbusPdu request;
+    if (!request.decode_request(frame)) return write_exception(frame, IllegalDataValue, writer);
+
+    ModbusPdu response;
+    switch (request.kind()) {
+    case ModbusPdu::ReadHoldingRegistersRequestPdu: {
+        const ModbusPdu::ReadRequest& read = request.read_request();
+        if (read.numberOfRegisters == 0 || read.numberOfRegisters > MODBUS_MAX_READ_REGISTERS) {
+            return write_exception(frame, IllegalDataValue, writer);
+        }
+        ModbusPdu::ReadResponse& registers = response.make_read_response();
+        registers.numberOfRegisters = read.numberOfRegisters;
+        if (!image.read(read.startingAddress, read.numberOfRegisters, registers.registers)) {
+            return write_exception(frame, IllegalDataAddress, writer);
+        }
+        break;
+    }
+    case ModbusPdu::WriteMultipleRegistersRequestPdu: {
+        const ModbusPdu::WriteRequest& write = request.write_request();
+        if (write.numberOfRegisters == 0) return write_exception(frame, IllegalDataValue, writer);
+        if (!image.write(write.startingAddress, write.registers, write.numberOfRegisters)) {
+            return write_exception(frame, IllegalDataAddress, writer);
+        }
+        ModbusPdu::WriteResponse& written = response.make_write_response();
+        written.startingAddress = write.startingAddress;
+        written.numberOfRegisters = write.numberOfRegisters;
+        break;
+    }
+    default:
+        return write_exception(frame, IllegalFunction, writer);
+    }
+    response.write(writer, frame.transactionId, frame.unitId);
+    return false;
+}
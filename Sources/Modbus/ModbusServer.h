@@ -0,0 +1,122 @@
+#ifndef _MODBUS_SERVER_H
+#define _MODBUS_SERVER_H
+
+#include <map>
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+#include <Reactor.h>
+#include "Modbus.h"
+#include "ModbusFrame.h"
+#include "ModbusPdu.h"
+#include "ModbusRegisterImage.h"
+
+namespace j2 {
+
+    /** @brief Standard Modbus TCP port. */
+    const uint16_t MODBUS_TCP_PORT = 502;
+
+    /** @brief Default most clients a @c ModbusServer serves at once. */
+    const std::size_t DEFAULT_MODBUS_CONNECTIONS = 512;
+
+    /** @brief Counts of the traffic of a @c ModbusServer. */
+    struct ModbusServerStats {
+        ModbusServerStats() : accepted(0), rejected(0), closed(0), requests(0), exceptions(0) { }
+
+        std::size_t accepted;       ///< Connections accepted
+        std::size_t rejected;       ///< Connections refused for being over the limit
+        std::size_t closed;         ///< Connections closed, by either end
+        std::size_t requests;       ///< Requests answered
+        std::size_t exceptions;     ///< Requests answered with an exception response
+    };
+
+    /**
+     * @brief Event driven Modbus TCP server of a register image.
+     *
+     * Serves @c ReadHoldingRegisters and @c WriteMultipleRegisters, and
+     * answers other functions with @c IllegalFunction.  The listening
+     * socket and every connection are watched by a single @c Reactor, so
+     * hundreds of clients are served by the thread calling its @c wait
+     * rather than a thread each.  The register image may be updated from
+     * other threads meanwhile, for instance by a @c RegisterImageModule.
+     *
+     * Requests pipelined by a client are answered in turn.  Responses the
+     * socket cannot take at once are sent as it becomes writable, and a
+     * client that stops reading its responses while sending more requests
+     * is disconnected once @c MAX_PENDING_OUTPUT bytes of responses are
+     * waiting for it.  Requests are decoded into a @c ModbusPdu and
+     * answered into the connection's own output buffer, so once buffers
+     * have grown to the traffic, serving allocates nothing.  All members
+     * must be called from the reactor's thread.
+     */
+    class ModbusServer {
+    public:
+        static const std::size_t MAX_PENDING_OUTPUT = 64 * 1024;
+
+        /**
+         * @param reactor reactor watching the sockets
+         * @param image registers served, which must outlive the server
+         * @param max_connections most clients served at once
+         */
+        ModbusServer(Reactor& reactor,
+                     ModbusRegisterImage& image,
+                     std::size_t max_connections = DEFAULT_MODBUS_CONNECTIONS);
+
+        ~ModbusServer();
+
+        /**
+         * @brief Listen for clients.
+         * @param address local address to listen on; all addresses if empty
+         * @param port port to listen on; chosen by the system if 0
+         * @throws ModbusException if the port cannot be listened on
+         */
+        void listen(const std::string& address = "", uint16_t port = MODBUS_TCP_PORT);
+
+        /** @brief Stop listening and close every connection. */
+        void close();
+
+        /** @brief Port listened on, or 0 if not listening. */
+        uint16_t port() const { return _port; }
+
+        /** @brief Number of clients connected. */
+        std::size_t connections() const { return _connections.size(); }
+
+        ModbusServerStats stats() const { return _stats; }
+
+        /**
+         * @brief Write the response to the request in @c frame, answering
+         * from @c image.
+         * @return whether the response is an exception response
+         */
+        static bool respond(ModbusRegisterImage& image, const ModbusFrame& frame, IoWriter& writer);
+
+    private:
+        struct Connection {
+            Connection() : writing(false) { }
+
+            buffer input;
+            shared_buffer output;
+            bool writing;           ///< Whether watched for writability
+        };
+
+        void accept();
+        void ready(int fd);
+        bool flush(int fd, Connection& connection);
+        void disconnect(int fd);
+
+        // Not copyable
+        ModbusServer(const ModbusServer&);
+        ModbusServer& operator=(const ModbusServer&);
+
+        Reactor& _reactor;
+        ModbusRegisterImage& _image;
+        const std::size_t _max_connections;
+        int _listener;
+        uint16_t _port;
+        std::map<int, Connection> _connections;
+        ModbusServerStats _stats;
+    };
+
+} // namespace j2
+
+#endif // _MODBUS_SERVER_H
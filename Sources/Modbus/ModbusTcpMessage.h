@@ -10,11 +10,12 @@
 
 namespace j2 {
 
-    class ModbusException: public std::runtime_error {
-    public:
-        explicit ModbusException(const std::string &err) : runtime_error(err) {}
-    };
-    
+    /** @brief Bytes of a Modbus TCP frame before those counted by its size field */
+    const std::size_t MODBUS_TCP_PREFIX = 6;
+
+    /** @brief Largest Modbus TCP frame */
+    const std::size_t MODBUS_TCP_MAX_FRAME = 260;
+
     class ModbusTcpMessage : public Serializable {
     public:
         ModbusTcpMessage() : _data(new buffer) {
@@ -25,12 +26,12 @@ namespace j2 {
                          const ModbusMessage& message) :
             transactionId(transactionId),
             protocolId(0),
-            size(message.size() + sizeof(unitId) + sizeof(functionCode)),
+            size(message.size() + sizeof(this->unitId) + sizeof(this->functionCode)),
             unitId(unitId),
             functionCode(message.functionCode()),
             _data(new buffer)            
         {
-            _data->reserve(message.size() - (sizeof(unitId) + sizeof(functionCode)));
+            _data->reserve(message.size());
             MemoryIoWriter writer(_data);
             message.serialize(writer);
         }
@@ -74,6 +75,9 @@ namespace j2 {
 
         const buffer& data() const { return *_data; }
 
+        /** @brief Whether the message is an exception response */
+        bool isException() const { return (functionCode & MODBUS_EXCEPTION_FLAG) != 0; }
+
     public:
         uint16_t transactionId;       // Unique transaction id
         uint16_t protocolId;          // Must be zero for Modbus TCP
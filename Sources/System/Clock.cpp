@@ -0,0 +1,5 @@
+#include "Clock.h"
+
+using namespace j2;
+
+boost::atomic<const ClockSource*> Clock::_source(0);
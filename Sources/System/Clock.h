@@ -0,0 +1,107 @@
+#ifndef _CLOCK_H
+#define _CLOCK_H
+
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+
+namespace j2 {
+
+    /**
+     * @brief Source of the current time for @c Clock.
+     */
+    class ClockSource {
+    public:
+        typedef boost::chrono::steady_clock::time_point time_point;
+        typedef boost::chrono::steady_clock::duration duration;
+
+        virtual ~ClockSource() { }
+
+        virtual time_point now() const = 0;
+    };
+
+    /**
+     * @brief Clock used for all timestamps, timers and deadlines.
+     *
+     * Meets the requirements of a boost::chrono clock and has the same time
+     * points as @c boost::chrono::steady_clock, from which it reads the time
+     * unless another @c ClockSource, such as a @c SimulatedClock, has been
+     * installed with @c set_source.  Replaying recorded data through a
+     * simulated clock then gives the same timestamps as the real run,
+     * however fast it is replayed.
+     */
+    class Clock {
+    public:
+        typedef boost::chrono::steady_clock::duration duration;
+        typedef duration::rep rep;
+        typedef duration::period period;
+        typedef boost::chrono::steady_clock::time_point time_point;
+        static const bool is_steady = true;
+
+        static time_point now() {
+            const ClockSource* source = _source.load(boost::memory_order_acquire);
+            return source ? source->now() : boost::chrono::steady_clock::now();
+        }
+
+        /**
+         * @brief Read the time from @c source, or from the steady clock if 0.
+         * The source must outlive its use.
+         */
+        static void set_source(const ClockSource* source) {
+            _source.store(source, boost::memory_order_release);
+        }
+
+        static const ClockSource* source() {
+            return _source.load(boost::memory_order_acquire);
+        }
+
+    private:
+        static boost::atomic<const ClockSource*> _source;
+    };
+
+    /**
+     * @brief Clock source whose time only changes when it is set or advanced,
+     * for deterministic tests and faster than real time replay.
+     */
+    class SimulatedClock : public ClockSource {
+    public:
+        explicit SimulatedClock(time_point start = boost::chrono::steady_clock::now()) :
+            _now(start.time_since_epoch().count()) { }
+
+        virtual time_point now() const {
+            return time_point(duration(_now.load(boost::memory_order_acquire)));
+        }
+
+        /** @brief Move to @c time; a simulated clock may not go backwards. */
+        void set(time_point time) {
+            if (time > now()) _now.store(time.time_since_epoch().count(), boost::memory_order_release);
+        }
+
+        void advance(duration step) {
+            _now.fetch_add(step.count(), boost::memory_order_acq_rel);
+        }
+
+    private:
+        boost::atomic<duration::rep> _now;
+    };
+
+    /** @brief Install a clock source for the lifetime of a scope. */
+    class ScopedClockSource {
+    public:
+        explicit ScopedClockSource(const ClockSource& source) :
+            _previous(Clock::source()) {
+            Clock::set_source(&source);
+        }
+
+        ~ScopedClockSource() { Clock::set_source(_previous); }
+
+    private:
+        // Not copyable
+        ScopedClockSource(const ScopedClockSource&);
+        ScopedClockSource& operator=(const ScopedClockSource&);
+
+        const ClockSource* _previous;
+    };
+
+} // namespace j2
+
+#endif // _CLOCK_H
@@ -0,0 +1,162 @@
+#ifndef _DEADLINE_SCHEDULER_H
+#define _DEADLINE_SCHEDULER_H
+
+#include <vector>
+#include <stdexcept>
+#include <boost/optional.hpp>
+#include <boost/chrono.hpp>
+#include <Supervisor.h>
+
+namespace j2 {
+
+    /** @brief Timing of the cycles of one periodic module. */
+    struct DeadlineStats {
+        DeadlineStats() : runs(0), misses(0), skipped(0), total_lateness(0), max_lateness(0) { }
+
+        std::size_t runs;                       ///< Cycles run
+        std::size_t misses;                     ///< Cycles finished after their deadline
+        std::size_t skipped;                    ///< Cycles dropped because the module fell a whole period behind
+        EventClock::duration total_lateness;    ///< Sum of time finished past the deadline
+        EventClock::duration max_lateness;      ///< Largest time finished past the deadline
+    };
+
+    /**
+     * @class Scheduler running periodic modules ahead of event processing.
+     *
+     * A periodic module is released once per period.  When released its
+     * queued events are delivered and its @c Module::update run, which must
+     * finish within the module's deadline, measured from the release.  Among
+     * released modules the one run first is the one with the earliest
+     * deadline, or with @c RateMonotonic the one with the shortest period.
+     * Only when no periodic module is released are events of other modules
+     * processed, by the best-effort scheduler.
+     *
+     * Not thread safe; configure it before scheduling and schedule from one
+     * thread.
+     */
+    class DeadlineScheduler : public Scheduler {
+    public:
+        enum Order {
+            EarliestDeadlineFirst,
+            RateMonotonic
+        };
+
+        explicit DeadlineScheduler(Order order = EarliestDeadlineFirst,
+                                   Scheduler* best_effort = BasicScheduler::instance()) :
+            _order(order),
+            _best_effort(best_effort) { }
+
+        /**
+         * @brief Run a module's @c update every @c period, first released now.
+         * @param deadline time after each release by which the update must
+         *  finish; the period if zero
+         * @throws std::invalid_argument if @c period is not positive
+         */
+        void set_period(const SharedModule& module,
+                        EventClock::duration period,
+                        EventClock::duration deadline = EventClock::duration::zero()) {
+            if (period <= EventClock::duration::zero()) {
+                throw std::invalid_argument("Period must be positive");
+            }
+            Task* task = find(module.get());
+            if (!task) {
+                _tasks.push_back(Task());
+                task = &_tasks.back();
+                task->module = module;
+            }
+            task->period = period;
+            task->deadline = deadline == EventClock::duration::zero() ? period : deadline;
+            task->release = EventClock::now();
+        }
+
+        /** @brief Deadline statistics of a periodic module; empty for other modules. */
+        DeadlineStats deadline_stats(const Module* module) const {
+            for (Tasks::const_iterator it = _tasks.begin(); it != _tasks.end(); ++it) {
+                if (it->module.get() == module) return it->stats;
+            }
+            return DeadlineStats();
+        }
+
+        /** @brief When the next periodic module is released, if there is one. */
+        virtual boost::optional<EventClock::time_point> next_release() const {
+            boost::optional<EventClock::time_point> next;
+            for (Tasks::const_iterator it = _tasks.begin(); it != _tasks.end(); ++it) {
+                if (!next || it->release < *next) next = it->release;
+            }
+            return next;
+        }
+
+        virtual void attach(const SharedModule& module) {
+            _best_effort->attach(module);
+        }
+
+        virtual boost::optional<Module*> schedule(const ModuleList& modules) {
+            EventClock::time_point now = EventClock::now();
+            Task* task = released(now);
+            if (!task) return _best_effort->schedule(modules);
+
+            task->module->process_all();
+            task->module->update();
+            complete(*task, EventClock::now());
+            return boost::optional<Module*>(task->module.get());
+        }
+
+    private:
+        struct Task {
+            SharedModule module;
+            EventClock::duration period;
+            EventClock::duration deadline;
+            EventClock::time_point release;
+            DeadlineStats stats;
+        };
+
+        typedef std::vector<Task> Tasks;
+
+        Task* find(const Module* module) {
+            for (Tasks::iterator it = _tasks.begin(); it != _tasks.end(); ++it) {
+                if (it->module.get() == module) return &*it;
+            }
+            return 0;
+        }
+
+        // Released task to run first, if any
+        Task* released(EventClock::time_point now) {
+            Task* first = 0;
+            for (Tasks::iterator it = _tasks.begin(); it != _tasks.end(); ++it) {
+                if (it->release > now) continue;
+                if (!first || precedes(*it, *first)) first = &*it;
+            }
+            return first;
+        }
+
+        bool precedes(const Task& a, const Task& b) const {
+            if (_order == RateMonotonic) return a.period < b.period;
+            return a.release + a.deadline < b.release + b.deadline;
+        }
+
+        void complete(Task& task, EventClock::time_point finished) {
+            DeadlineStats& stats = task.stats;
+            stats.runs++;
+            EventClock::duration lateness = finished - (task.release + task.deadline);
+            if (lateness > EventClock::duration::zero()) {
+                stats.misses++;
+                stats.total_lateness += lateness;
+                if (lateness > stats.max_lateness) stats.max_lateness = lateness;
+            }
+            // Keep to the original cycle; releases that have already passed
+            // are dropped rather than run back to back
+            task.release += task.period;
+            while (task.release + task.period <= finished) {
+                task.release += task.period;
+                stats.skipped++;
+            }
+        }
+
+        const Order _order;
+        Scheduler* _best_effort;
+        Tasks _tasks;
+    };
+
+} // namespace j2
+
+#endif // _DEADLINE_SCHEDULER_H
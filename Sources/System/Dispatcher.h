@@ -0,0 +1,516 @@
+#ifndef _DISPATCHER_H
+#define _DISPATCHER_H
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <tr1/memory>
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace j2 {
+
+    /** @brief Size in bytes of the buffer used to store a @c Delegate target inline. */
+    const std::size_t DELEGATE_INLINE_SIZE = 6 * sizeof(void*);
+
+    /**
+     * @brief Storage shared by all @c Delegate signatures.
+     *
+     * Targets that fit in @c DELEGATE_INLINE_SIZE bytes are constructed in place,
+     * larger ones are allocated once when the delegate is created.  Invoking a
+     * delegate never allocates.
+     */
+    class DelegateBase {
+    public:
+        bool empty() const { return _manager == 0; }
+
+    protected:
+        typedef boost::aligned_storage<DELEGATE_INLINE_SIZE>::type Buffer;
+
+        // Copy and destroy operations for the stored target
+        struct Manager {
+            void (*copy)(const Buffer& from, Buffer& to);
+            void (*destroy)(Buffer& buffer);
+        };
+
+        template <typename F>
+        struct FitsInline {
+            static const bool value =
+                sizeof(F) <= sizeof(Buffer) &&
+                boost::alignment_of<F>::value <= boost::alignment_of<Buffer>::value;
+        };
+
+        // Target stored inline in the buffer
+        template <typename F, bool INLINE = FitsInline<F>::value>
+        struct Store {
+            static void create(Buffer& buffer, const F& f) {
+                new (buffer.address()) F(f);
+            }
+
+            static F& get(const Buffer& buffer) {
+                return *static_cast<F*>(const_cast<void*>(buffer.address()));
+            }
+
+            static void copy(const Buffer& from, Buffer& to) { create(to, get(from)); }
+
+            static void destroy(Buffer& buffer) { get(buffer).~F(); }
+
+            static const Manager* manager() {
+                static const Manager manager = { &copy, &destroy };
+                return &manager;
+            }
+        };
+
+        // Target too large for the buffer, which holds a pointer to it instead
+        template <typename F>
+        struct Store<F, false> {
+            static void create(Buffer& buffer, const F& f) {
+                *static_cast<F**>(buffer.address()) = new F(f);
+            }
+
+            static F& get(const Buffer& buffer) {
+                return **static_cast<F* const*>(buffer.address());
+            }
+
+            static void copy(const Buffer& from, Buffer& to) { create(to, get(from)); }
+
+            static void destroy(Buffer& buffer) { delete &get(buffer); }
+
+            static const Manager* manager() {
+                static const Manager manager = { &copy, &destroy };
+                return &manager;
+            }
+        };
+
+        DelegateBase() : _manager(0) { }
+
+        DelegateBase(const DelegateBase& other) : _manager(0) {
+            assign(other);
+        }
+
+        DelegateBase& operator=(const DelegateBase& other) {
+            if (this != &other) {
+                reset();
+                assign(other);
+            }
+            return *this;
+        }
+
+        ~DelegateBase() { reset(); }
+
+        template <typename F>
+        void create(const F& f) {
+            Store<F>::create(_buffer, f);
+            _manager = Store<F>::manager();
+        }
+
+    protected:
+        Buffer _buffer;
+
+    private:
+        void assign(const DelegateBase& other) {
+            if (!other._manager) return;
+            other._manager->copy(other._buffer, _buffer);
+            _manager = other._manager;
+        }
+
+        void reset() {
+            if (_manager) _manager->destroy(_buffer);
+            _manager = 0;
+        }
+
+        const Manager* _manager;
+    };
+
+    /**
+     * @brief Small-buffer-optimised callback.
+     *
+     * Similar to @c std::tr1::function but the target is stored inline where
+     * possible and is invoked through a single function pointer.  Only the
+     * signatures used by @c Dispatcher are supported.
+     */
+    template <typename Signature> class Delegate;
+
+    template <typename A1>
+    class Delegate<void (A1)> : public DelegateBase {
+    public:
+        Delegate() : _invoke(0) { }
+
+        template <typename F>
+        Delegate(const F& f) : _invoke(&invoke<F>) { create(f); }
+
+        void operator()(A1 a1) const { _invoke(_buffer, a1); }
+
+    private:
+        template <typename F>
+        static void invoke(const Buffer& buffer, A1 a1) {
+            Store<F>::get(buffer)(a1);
+        }
+
+        void (*_invoke)(const Buffer&, A1);
+    };
+
+    template <typename A1, typename A2>
+    class Delegate<void (A1, A2)> : public DelegateBase {
+    public:
+        Delegate() : _invoke(0) { }
+
+        template <typename F>
+        Delegate(const F& f) : _invoke(&invoke<F>) { create(f); }
+
+        void operator()(A1 a1, A2 a2) const { _invoke(_buffer, a1, a2); }
+
+    private:
+        template <typename F>
+        static void invoke(const Buffer& buffer, A1 a1, A2 a2) {
+            Store<F>::get(buffer)(a1, a2);
+        }
+
+        void (*_invoke)(const Buffer&, A1, A2);
+    };
+
+    /**
+     * @brief Interface used by @c Connection to manage a connected delegate.
+     */
+    class ConnectionTarget {
+    public:
+        virtual ~ConnectionTarget() { }
+
+        virtual void block(unsigned id, bool blocked) = 0;
+
+        virtual void disconnect(unsigned id) = 0;
+
+        virtual bool connected(unsigned id) const = 0;
+    };
+
+    /**
+     * @brief Handle to a delegate connected to a @c Dispatcher.
+     *
+     * The handle does not keep the dispatcher alive; operations on a
+     * connection whose dispatcher has been destroyed are ignored.
+     */
+    class Connection {
+    public:
+        Connection() : _id(0) { }
+
+        Connection(std::tr1::weak_ptr<ConnectionTarget> target, unsigned id) :
+            _target(target),
+            _id(id) { }
+
+        /** @brief Temporarily stop delivering to the delegate. */
+        void block() { set_blocked(true); }
+
+        /** @brief Resume delivering to the delegate. */
+        void unblock() { set_blocked(false); }
+
+        /** @brief Permanently remove the delegate from the dispatcher. */
+        void disconnect() {
+            std::tr1::shared_ptr<ConnectionTarget> target = _target.lock();
+            if (target) target->disconnect(_id);
+        }
+
+        /** @brief Whether the delegate is still connected. */
+        bool connected() const {
+            std::tr1::shared_ptr<ConnectionTarget> target = _target.lock();
+            return target && target->connected(_id);
+        }
+
+    private:
+        void set_blocked(bool blocked) {
+            std::tr1::shared_ptr<ConnectionTarget> target = _target.lock();
+            if (target) target->block(_id, blocked);
+        }
+
+        std::tr1::weak_ptr<ConnectionTarget> _target;
+        unsigned _id;
+    };
+
+    /**
+     * @brief Slot management shared by all @c Dispatcher signatures.
+     *
+     * Delegates are kept in a contiguous vector and emitting walks it in
+     * order.  Dispatchers must be owned by a @c std::tr1::shared_ptr so that
+     * connections can refer back to them.
+     *
+     * A single threaded dispatcher modifies the vector in place.  Connecting
+     * or disconnecting from inside a delegate is allowed: the change is
+     * deferred until the outermost emit completes, so the vector is never
+     * reallocated while it is being walked.
+     *
+     * A concurrent dispatcher may be emitted from any number of threads while
+     * other threads connect, block or disconnect.  The vector is treated as an
+     * immutable snapshot: writers serialise on a mutex, copy the vector, modify
+     * the copy and atomically publish it, while each emit walks whichever
+     * snapshot was current when it started.  A delegate may therefore still be
+     * called by an emit already in progress when it is blocked or disconnected.
+     *
+     * Taking the snapshot is not lock free: @c boost::atomic_load of a
+     * @c shared_ptr holds one of Boost's pooled spinlocks while it increments
+     * the snapshot's reference count.  Emits never wait for a writer copying
+     * the vector, only for that brief spinlock, but threads emitting the same
+     * dispatcher do contend on the reference count.
+     */
+    template <typename Signature>
+    class DispatcherBase : public ConnectionTarget,
+                           public std::tr1::enable_shared_from_this< DispatcherBase<Signature> > {
+    public:
+        typedef Delegate<Signature> delegate_type;
+
+        DispatcherBase(bool concurrent = false) :
+            _slots(new Slots),
+            _concurrent(concurrent),
+            _next_id(1),
+            _live(0),
+            _depth(0),
+            _dirty(false) { }
+
+        /** @brief Whether this dispatcher is safe to use from multiple threads. */
+        bool is_concurrent() const { return _concurrent; }
+
+        /**
+         * @brief Add a delegate to the end of the dispatch list.
+         * @return a @c Connection that can be used to block or disconnect it
+         */
+        Connection connect(const delegate_type& delegate) {
+            unsigned id;
+            if (_concurrent) {
+                boost::mutex::scoped_lock lock(_mutex);
+                id = _next_id++;
+                SlotsPtr slots(new Slots(*_slots));
+                slots->push_back(Slot(delegate, id));
+                boost::atomic_store(&_slots, slots);
+            } else {
+                id = _next_id++;
+                if (_depth) {
+                    _pending.push_back(Slot(delegate, id));
+                } else {
+                    _slots->push_back(Slot(delegate, id));
+                }
+            }
+            _live++;
+            return Connection(this->shared_from_this(), id);
+        }
+
+        /** @brief Remove all delegates. */
+        void disconnect_all() {
+            if (_concurrent) {
+                boost::mutex::scoped_lock lock(_mutex);
+                boost::atomic_store(&_slots, SlotsPtr(new Slots));
+                _live = 0;
+                return;
+            }
+            for (typename Slots::iterator it = _slots->begin(); it != _slots->end(); ++it) {
+                remove(*it);
+            }
+            _pending.clear();
+            _live = 0;
+            compact();
+        }
+
+        /** @brief Number of connected delegates. */
+        std::size_t size() const { return _live; }
+
+        /** @brief Whether there are no connected delegates. */
+        bool empty() const { return _live == 0; }
+
+        void block(unsigned id, bool blocked) {
+            if (_concurrent) {
+                boost::mutex::scoped_lock lock(_mutex);
+                SlotsPtr slots(new Slots(*_slots));
+                Slot* slot = find(*slots, id);
+                if (!slot) return;
+                slot->blocked = blocked;
+                boost::atomic_store(&_slots, slots);
+                return;
+            }
+            Slot* slot = find(id);
+            if (slot) slot->blocked = blocked;
+        }
+
+        void disconnect(unsigned id) {
+            if (_concurrent) {
+                boost::mutex::scoped_lock lock(_mutex);
+                if (!find(*_slots, id)) return;
+                SlotsPtr slots(new Slots);
+                slots->reserve(_slots->size() - 1);
+                for (typename Slots::const_iterator it = _slots->begin(); it != _slots->end(); ++it) {
+                    if (it->id != id) slots->push_back(*it);
+                }
+                boost::atomic_store(&_slots, slots);
+                _live--;
+                return;
+            }
+            Slot* slot = find(id);
+            if (!slot) return;
+            remove(*slot);
+            _live--;
+            compact();
+        }
+
+        bool connected(unsigned id) const {
+            if (_concurrent) {
+                SlotsPtr slots = boost::atomic_load(&_slots);
+                return find(*slots, id) != 0;
+            }
+            return const_cast<DispatcherBase*>(this)->find(id) != 0;
+        }
+
+    protected:
+        struct Slot {
+            Slot(const delegate_type& delegate, unsigned id) :
+                delegate(delegate),
+                id(id),
+                blocked(false) { }
+
+            delegate_type delegate;
+            unsigned id;        // Zero once disconnected
+            bool blocked;
+        };
+
+        typedef std::vector<Slot> Slots;
+        typedef boost::shared_ptr<Slots> SlotsPtr;
+
+        // Tracks nested emits so that changes to _slots are deferred
+        class EmitGuard {
+        public:
+            EmitGuard(DispatcherBase& dispatcher) : _dispatcher(dispatcher) {
+                _dispatcher._depth++;
+            }
+
+            ~EmitGuard() {
+                if (--_dispatcher._depth == 0) _dispatcher.compact();
+            }
+
+        private:
+            DispatcherBase& _dispatcher;
+        };
+
+        // Snapshot of the slots for a concurrent emit
+        SlotsPtr snapshot() const { return boost::atomic_load(&_slots); }
+
+        SlotsPtr _slots;
+        const bool _concurrent;
+
+    private:
+        static Slot* find(const Slots& slots, unsigned id) {
+            if (id == 0) return 0;
+            for (typename Slots::const_iterator it = slots.begin(); it != slots.end(); ++it) {
+                if (it->id == id) return const_cast<Slot*>(&*it);
+            }
+            return 0;
+        }
+
+        Slot* find(unsigned id) {
+            Slot* slot = find(*_slots, id);
+            return slot ? slot : find(_pending, id);
+        }
+
+        // Mark a slot as disconnected; it is blocked so that an emit in
+        // progress skips it until it can be erased.
+        void remove(Slot& slot) {
+            slot.id = 0;
+            slot.blocked = true;
+            _dirty = true;
+        }
+
+        // Erase disconnected slots and append any that were connected during
+        // an emit.  Does nothing while an emit is in progress.
+        void compact() {
+            if (_depth) return;
+            Slots& slots = *_slots;
+            if (_dirty) {
+                typename Slots::iterator out = slots.begin();
+                for (typename Slots::iterator it = slots.begin(); it != slots.end(); ++it) {
+                    if (it->id == 0) continue;
+                    if (out != it) *out = *it;
+                    ++out;
+                }
+                slots.erase(out, slots.end());
+                _dirty = false;
+            }
+            for (typename Slots::iterator it = _pending.begin(); it != _pending.end(); ++it) {
+                if (it->id != 0) slots.push_back(*it);
+            }
+            _pending.clear();
+        }
+
+        Slots _pending;
+        boost::mutex _mutex;
+        unsigned _next_id;
+        boost::atomic<std::size_t> _live;
+        int _depth;
+        bool _dirty;
+    };
+
+    /**
+     * @brief Flat list of delegates invoked in connection order.
+     *
+     * Replaces @c boost::signal for event delivery: emitting is a loop over a
+     * contiguous vector that performs no allocation.  A single threaded
+     * dispatcher takes no locks; a concurrent one takes a snapshot of the
+     * vector (see @c DispatcherBase).
+     *
+     * @tparam Signature @c void(A1) or @c void(A1, A2)
+     */
+    template <typename Signature> class Dispatcher;
+
+    template <typename A1>
+    class Dispatcher<void (A1)> : public DispatcherBase<void (A1)> {
+    private:
+        typedef DispatcherBase<void (A1)> Base;
+    public:
+        Dispatcher(bool concurrent = false) : Base(concurrent) { }
+
+        void operator()(A1 a1) {
+            if (this->_concurrent) {
+                typename Base::SlotsPtr slots = this->snapshot();
+                emit(*slots, a1);
+            } else {
+                typename Base::EmitGuard guard(*this);
+                emit(*this->_slots, a1);
+            }
+        }
+
+    private:
+        static void emit(const typename Base::Slots& slots, A1 a1) {
+            const std::size_t n = slots.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                const typename Base::Slot& slot = slots[i];
+                if (!slot.blocked) slot.delegate(a1);
+            }
+        }
+    };
+
+    template <typename A1, typename A2>
+    class Dispatcher<void (A1, A2)> : public DispatcherBase<void (A1, A2)> {
+    private:
+        typedef DispatcherBase<void (A1, A2)> Base;
+    public:
+        Dispatcher(bool concurrent = false) : Base(concurrent) { }
+
+        void operator()(A1 a1, A2 a2) {
+            if (this->_concurrent) {
+                typename Base::SlotsPtr slots = this->snapshot();
+                emit(*slots, a1, a2);
+            } else {
+                typename Base::EmitGuard guard(*this);
+                emit(*this->_slots, a1, a2);
+            }
+        }
+
+    private:
+        static void emit(const typename Base::Slots& slots, A1 a1, A2 a2) {
+            const std::size_t n = slots.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                const typename Base::Slot& slot = slots[i];
+                if (!slot.blocked) slot.delegate(a1, a2);
+            }
+        }
+    };
+
+} // namespace j2
+
+#endif // _DISPATCHER_H
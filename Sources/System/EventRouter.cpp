@@ -1,28 +1,148 @@
 #include "EventRouter.h"
+#include <boost/thread/once.hpp>
 
 using namespace j2;
 
 EventRouter* EventRouter::default_instance = 0;
 
+static boost::once_flag default_instance_flag = BOOST_ONCE_INIT;
+
+void EventRouter::create_default_instance() {
+    EventRouter::default_instance = new EventRouter(MultiThreaded);
+}
+
 EventRouter* EventRouter::instance() { 
-    if (EventRouter::default_instance) return EventRouter::default_instance;
-    EventRouter::default_instance = new EventRouter(); 
+    boost::call_once(&EventRouter::create_default_instance, default_instance_flag);
     return EventRouter::default_instance;
 }
 
-void EventRouter::deliver(const std::string& name, const boost::any value) {
-    (*signal_for(name))(name, value);
+EventRouter::~EventRouter() {
+    const std::size_t count = _topic_count;
+    for (std::size_t i = 0; i < count; i++) {
+        delete &topic_entry(i);
+    }
+    for (std::size_t i = 0; i < MAX_TOPIC_CHUNKS && _chunks[i]; i++) {
+        delete[] _chunks[i];
+    }
 }
 
 Subscription<> EventRouter::subscribe(const std::string& name,
-                                      std::tr1::function<void (const std::string&, boost::any)> callback) {
+                                      std::tr1::function<void (const std::string&, const boost::any&)> callback) {
+    if (is_topic_pattern(name)) {
+        return Subscription<>(*this, name, connect_pattern(name, callback));
+    }
+    return subscribe(topic(name), callback);
+}
+
+Subscription<> EventRouter::subscribe(TopicId topic,
+                                      std::tr1::function<void (const std::string&, const boost::any&)> callback) {
     return Subscription<>(*this,
-                          name,
-                          signal_for(name)->connect(callback));
+                          topic,
+                          signal_for(topic)->connect(callback));
+}
+
+TopicId EventRouter::topic(const std::string& name) {
+    typedef std::tr1::unordered_map<std::string, TopicId>::const_iterator iterator;
+    {
+        boost::shared_lock<TopicMutex> lock(_topic_mutex, boost::defer_lock);
+        if (_concurrent) lock.lock();
+        iterator it = _topic_ids.find(name);
+        if (it != _topic_ids.end()) return it->second;
+    }
+
+    boost::unique_lock<TopicMutex> lock(_topic_mutex, boost::defer_lock);
+    if (_concurrent) lock.lock();
+    // Another thread may have created the topic while we were unlocked
+    iterator it = _topic_ids.find(name);
+    if (it != _topic_ids.end()) return it->second;
+
+    if (is_topic_pattern(name)) {
+        throw std::invalid_argument("Cannot publish to topic pattern " + name);
+    }
+    TopicId result = _topic_count.load(boost::memory_order_relaxed);
+    if (result >= MAX_TOPIC_CHUNKS * TOPIC_CHUNK_SIZE) {
+        throw std::length_error("Too many topics");
+    }
+    Topic**& chunk = _chunks[result >> TOPIC_CHUNK_BITS];
+    if (!chunk) chunk = new Topic*[TOPIC_CHUNK_SIZE];
+    Topic* entry = new Topic(name, _concurrent);
+    chunk[result & (TOPIC_CHUNK_SIZE - 1)] = entry;
+    _topic_ids.insert(std::make_pair(name, result));
+
+    // Connect pattern subscribers now so that publishing need not match them
+    std::vector<PatternSlotPtr> matched;
+    _patterns.match(name, matched);
+    for (std::vector<PatternSlotPtr>::iterator it = matched.begin(); it != matched.end(); ++it) {
+        (*it)->attach(name, entry->signal);
+    }
+    _topic_count.store(result + 1, boost::memory_order_release);
+    return result;
+}
+
+namespace {
+    // Connects the same delegate to every topic matching a pattern
+    struct CONSTANT_DELEGATE {
+        CONSTANT_DELEGATE(const SignalDelegate& delegate) : delegate(delegate) { }
+        SignalDelegate operator()(const std::string&) const { return delegate; }
+        SignalDelegate delegate;
+    };
+}
+
+Connection EventRouter::connect_pattern(const std::string& pattern, const SignalDelegate& delegate) {
+    return connect_pattern_with(pattern, CONSTANT_DELEGATE(delegate));
+}
+
+Connection EventRouter::connect_pattern_with(const std::string& pattern,
+                                             const PatternDelegateFactory& make_delegate) {
+    PatternSlotPtr slot(new PatternSlot(*this, pattern, make_delegate));
+    boost::unique_lock<TopicMutex> lock(_topic_mutex, boost::defer_lock);
+    if (_concurrent) lock.lock();
+    _patterns.insert(pattern, slot);
+    const std::size_t count = _topic_count;
+    for (TopicId topic = 0; topic < count; topic++) {
+        const Topic& entry = topic_entry(topic);
+        if (TopicTrie<PatternSlotPtr>::matches(pattern, entry.name)) {
+            slot->attach(entry.name, entry.signal);
+        }
+    }
+    return Connection(slot, 1);
+}
+
+void EventRouter::PatternSlot::attach(const std::string& name, const SignalPtr& signal) {
+    Connection connection = signal->connect(_make_delegate(name));
+    if (_blocked) connection.block();
+    _connections.push_back(connection);
+}
+
+void EventRouter::PatternSlot::block(unsigned, bool blocked) {
+    boost::unique_lock<TopicMutex> lock(_router._topic_mutex, boost::defer_lock);
+    if (_router._concurrent) lock.lock();
+    if (!_connected) return;
+    _blocked = blocked;
+    for (std::vector<Connection>::iterator it = _connections.begin(); it != _connections.end(); ++it) {
+        if (blocked) {
+            it->block();
+        } else {
+            it->unblock();
+        }
+    }
+}
+
+void EventRouter::PatternSlot::disconnect(unsigned) {
+    // Keep ourselves alive until the connections have been removed
+    PatternSlotPtr self = shared_from_this();
+    boost::unique_lock<TopicMutex> lock(_router._topic_mutex, boost::defer_lock);
+    if (_router._concurrent) lock.lock();
+    if (!_connected) return;
+    _connected = false;
+    _router._patterns.erase(_pattern, self);
+    std::for_each(_connections.begin(), _connections.end(),
+                  boost::mem_fn(&Connection::disconnect));
+    _connections.clear();
 }
 
-SignalPtr EventRouter::signal_for(const std::string& name) {
-    SignalPtr result = _subscriptions[name];
-    if (result) return result;
-    return (_subscriptions[name] = SignalPtr(new Signal()));
+bool EventRouter::PatternSlot::connected(unsigned) const {
+    boost::shared_lock<TopicMutex> lock(_router._topic_mutex, boost::defer_lock);
+    if (_router._concurrent) lock.lock();
+    return _connected;
 }
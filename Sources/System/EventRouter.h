@@ -1,63 +1,171 @@
+#include <new>
 #include <string>
 #include <memory>
+#include <deque>
 #include <vector>
-#include <queue>
+#include <utility>
+#include <cstddef>
+#include <typeinfo>
+#include <stdexcept>
 #include <tr1/memory>
 #include <tr1/functional>
 #include <tr1/unordered_map>
+#include <algorithm>
 #include <boost/any.hpp>
-#include <boost/signal.hpp>
+#include <boost/optional.hpp>
 #include <boost/bind.hpp>
+#include <boost/mem_fn.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/chrono.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <Dispatcher.h>
+#include <TopicTrie.h>
+#include <Telemetry.h>
+#include <Clock.h>
 
 #ifndef _EVENT_ROUTER_H
 #define _EVENT_ROUTER_H
 
 namespace j2 {
 
+    /** @brief Signal used by @c EventRouter */
+    typedef Dispatcher<void (const std::string&, const boost::any&)> Signal;
+
+    /** @brief Delegate that can be connected to a @c Signal */
+    typedef Signal::delegate_type SignalDelegate;
+
     // Template to adapt a callback function to a specific type to a
-    // callback that can take boost::any and cast it.  This is used
+    // delegate that can take boost::any and cast it.  This is used
     // by Subscription::deliver_with
     template <typename T> struct ANY_FUNC_ADAPTOR {
-        static void ADAPT(const std::string& name,
-                          const boost::any value, 
-                          std::tr1::function<void (const std::string&, T)> func) {
-            func(name, boost::any_cast<T>(value));
+        ANY_FUNC_ADAPTOR(std::tr1::function<void (const std::string&, T)> func) :
+            func(func) { }
+
+        void operator()(const std::string& name, const boost::any& value) const {
+            func(name, boost::any_cast<const T&>(value));
         }
+
+        std::tr1::function<void (const std::string&, T)> func;
     };
 
     // Template to adapt a callback function to a specific type to a
-    // callback that can take boost::any and cast it.  This is used
-    // by Subscription::deliver_with
+    // delegate that can take boost::any and cast it.  This is used
+    // by Subscription::deliver_with2
     template <typename T> struct ANY_FUNC_ADAPTOR_NO_NAME {
-        static void ADAPT(const std::string& name,
-                          const boost::any value, 
-                          std::tr1::function<void (T)> func) {
-            func(boost::any_cast<T>(value));
+        ANY_FUNC_ADAPTOR_NO_NAME(std::tr1::function<void (T)> func) : func(func) { }
+
+        void operator()(const std::string&, const boost::any& value) const {
+            func(boost::any_cast<const T&>(value));
         }
+
+        std::tr1::function<void (T)> func;
     };
 
 
     // Template to adapt a callback function that takes a ptr 
     // (actually any class that supports unary *) to a 
-    // callback that can take boost::any and cast it.  This is used
+    // delegate that can take boost::any and cast it.  This is used
     // by Subscription::assign_to
     template <typename T, typename P> struct ANY_PTR_ADAPTOR {
-        static void ADAPT(const std::string& name, const boost::any item, P ptr) {
-            *ptr = boost::any_cast<T>(item);
+        ANY_PTR_ADAPTOR(P ptr) : ptr(ptr) { }
+
+        void operator()(const std::string&, const boost::any& item) const {
+            *ptr = boost::any_cast<const T&>(item);
         }
-    };
 
-    /** @brief Signal used by @c EventRouter */
-    typedef boost::signal<void (const std::string&, const boost::any)> Signal;
+        P ptr;
+    };
 
     /** @brief @c shared_ptr for Signal used by @c EventRouter */
     typedef std::tr1::shared_ptr<Signal> SignalPtr;
 
+    /**
+     * @brief Interned handle for an event name.
+     *
+     * A @c TopicId is a dense index into the topic table of the @c EventRouter
+     * that issued it (see @c EventRouter::topic) and is only meaningful for that
+     * router.  Resolve names once, at subscribe or bind time, and use the handle
+     * when publishing so that the name does not need to be hashed per event.
+     */
+    typedef std::size_t TopicId;
+
+    /** @brief @c TopicId of a @c Subscription to a topic pattern. */
+    const TopicId NO_TOPIC = TopicId(-1);
 
     // Forward declaration of EventRouter for Subscription
     class EventRouter;
 
+    // Forward declaration of Channel for EventRouter::channel
+    template <typename T> class Channel;
+
+    /**
+     * @brief Type erased base for the typed signal owned by a @c Channel.
+     *
+     * Allows @c EventRouter to hand events published through the untyped
+     * (@c boost::any) path to the typed subscribers of a @c Channel.
+     */
+    class ChannelBase {
+    public:
+        virtual ~ChannelBase() { }
+
+        /** @brief Deliver a boxed value to typed subscribers, casting it to their type. */
+        virtual void deliver(const boost::any& value) = 0;
+
+        /** @brief The type of value the channel carries. */
+        virtual const std::type_info& type() const = 0;
+    };
+
+    /** @brief @c shared_ptr for ChannelBase used by @c EventRouter */
+    typedef std::tr1::shared_ptr<ChannelBase> ChannelPtr;
+
+    /** @brief Signal of boxed values that a @c ChannelSignal cannot cast. */
+    typedef Dispatcher<void (const boost::any&)> MismatchSignal;
+
+    /**
+     * @brief Typed signal used by a @c Channel.
+     *
+     * Boxed values of another type are passed to the @c mismatched
+     * delegates, when any are connected, rather than failing to cast.
+     */
+    template <typename T>
+    class ChannelSignal : public ChannelBase,
+                          public Dispatcher<void (const T&)> {
+    public:
+        ChannelSignal(bool concurrent = false) :
+            Dispatcher<void (const T&)>(concurrent),
+            _mismatched(new MismatchSignal(concurrent)) { }
+
+        void deliver(const boost::any& value) {
+            if (value.type() != typeid(T) && !_mismatched->empty()) {
+                (*_mismatched)(value);
+                return;
+            }
+            (*this)(boost::any_cast<const T&>(value));
+        }
+
+        const std::type_info& type() const { return typeid(T); }
+
+        const std::tr1::shared_ptr<MismatchSignal>& mismatched() const { return _mismatched; }
+
+    private:
+        const std::tr1::shared_ptr<MismatchSignal> _mismatched;
+    };
+
+    // Assign a value delivered to a typed signal to the given pointer.  This
+    // is used by Channel::assign_to
+    template <typename T, typename P> struct ASSIGN_TO {
+        ASSIGN_TO(P ptr) : ptr(ptr) { }
+        void operator()(const T& value) const { *ptr = value; }
+        P ptr;
+    };
+
     /**
      * @brief Subscription to events published by an EventRouter.
      * 
@@ -83,27 +191,56 @@ namespace j2 {
     template <typename T=boost::any, class EVENT_ROUTER = EventRouter>
     class Subscription {
     private:
-        typedef std::vector<boost::signals::connection> connection_list;
+        typedef std::vector<Connection> connection_list;
     public:
         /** @brief Construct a @c Subscription from an existing connection. */
         Subscription(EVENT_ROUTER& parent,
-                     const std::string& name,
-                     boost::signals::connection connection) :
+                     TopicId topic,
+                     Connection connection) :
             _event_router(parent),
-            _name(name) {
+            _name(parent.topic_name(topic)),
+            _topic(topic) {
             _connections.push_back(connection);
         }
 
+        /** @brief Construct a @c Subscription to a topic pattern from an existing connection. */
+        Subscription(EVENT_ROUTER& parent,
+                     const std::string& pattern,
+                     Connection connection) :
+            _event_router(parent),
+            _name(pattern),
+            _topic(NO_TOPIC) {
+            _connections.push_back(connection);
+        }
 
-        /** @brief Construct an unbound @c Subscription. */
+        /**
+         * @brief Construct an unbound @c Subscription.
+         * @param parent router to subscribe to
+         * @param name name of the event, or a pattern (see @c is_topic_pattern)
+         *  matching the names of several events
+         */
         Subscription(EVENT_ROUTER& parent,
                      const std::string& name) :
             _event_router(parent),
-            _name(name) { }
+            _name(name),
+            _topic(is_topic_pattern(name) ? NO_TOPIC : parent.topic(name)) { }
+
+        /** @brief Construct an unbound @c Subscription to an interned topic. */
+        Subscription(EVENT_ROUTER& parent,
+                     TopicId topic) :
+            _event_router(parent),
+            _name(parent.topic_name(topic)),
+            _topic(topic) { }
 
         
         /** @brief The name of the event we are subscribing to. */
         const std::string& name() const { return _name; }
+
+        /**
+         * @brief The interned handle of the event we are subscribing to, or
+         * @c NO_TOPIC if subscribed to a pattern.
+         */
+        TopicId topic() const { return _topic; }
         
 
         /** 
@@ -112,7 +249,7 @@ namespace j2 {
          * @return a reference to the @c Subscription to allow chaining
          **/
         Subscription& assign_to(T* ptr) {
-            return adapt<T*>(ANY_PTR_ADAPTOR< T, T* >::ADAPT, ptr);
+            return connect(ANY_PTR_ADAPTOR< T, T* >(ptr));
         }
 
         /** 
@@ -121,8 +258,7 @@ namespace j2 {
          * @return a reference to the @c Subscription to allow chaining
          **/
         Subscription& assign_to(std::tr1::shared_ptr<T> ptr) {
-            return adapt< std::tr1::shared_ptr<T> >
-                (ANY_PTR_ADAPTOR< T, std::tr1::shared_ptr<T> >::ADAPT, ptr);
+            return connect(ANY_PTR_ADAPTOR< T, std::tr1::shared_ptr<T> >(ptr));
         }
 
         /** 
@@ -131,7 +267,7 @@ namespace j2 {
          * @return a reference to the @c Subscription to allow chaining
          **/
         Subscription& deliver_with(std::tr1::function<void (const std::string&, T)> func) {
-                return adapt< std::tr1::function<void (const std::string&, T)> >(ANY_FUNC_ADAPTOR<T>::ADAPT, func);
+            return connect(ANY_FUNC_ADAPTOR<T>(func));
         }
 
         /** 
@@ -140,7 +276,7 @@ namespace j2 {
          * @return a reference to the @c Subscription to allow chaining
          **/
         Subscription& deliver_with2(std::tr1::function<void (T)> func) {
-            return adapt< std::tr1::function<void (T)> >(ANY_FUNC_ADAPTOR_NO_NAME<T>::ADAPT, func);
+            return connect(ANY_FUNC_ADAPTOR_NO_NAME<T>(func));
         }
 
 
@@ -150,7 +286,7 @@ namespace j2 {
          **/
         void block() {
             std::for_each(_connections.begin(), _connections.end(),
-                          std::mem_fun(&boost::signals::connection::block));
+                          boost::mem_fn(&Connection::block));
         }
 
         /**
@@ -159,7 +295,7 @@ namespace j2 {
          **/
         void unblock() { 
             std::for_each(_connections.begin(), _connections.end(),
-                          std::mem_fun(&boost::signals::connection::unblock));
+                          boost::mem_fn(&Connection::unblock));
         }
 
         /**
@@ -167,39 +303,57 @@ namespace j2 {
          **/
         void unsubscribe() { 
             std::for_each(_connections.begin(), _connections.end(),
-                          std::mem_fun(&boost::signals::connection::disconnect));
+                          boost::mem_fn(&Connection::disconnect));
         }
 
     private:
-        // Template used in adapting callback/ptr assignment
-        template <typename DEST>
-        Subscription& adapt(std::tr1::function<void (const std::string&, 
-                                                     const boost::any,
-                                                     DEST)> func,
-                            DEST dest) {
-            SignalPtr signal = _event_router.signal_for(_name);
-            boost::signals::connection connection = 
-                signal->connect(boost::bind(func, _1, _2, dest));
-            _connections.push_back(connection);
+        // Connect an adapted callback/ptr assignment to the signal for our
+        // topic, or to the signals of every topic matching our pattern
+        Subscription& connect(const SignalDelegate& delegate) {
+            if (_topic == NO_TOPIC) {
+                _connections.push_back(_event_router.connect_pattern(_name, delegate));
+            } else {
+                _connections.push_back(_event_router.signal_for(_topic)->connect(delegate));
+            }
             return *this;
         }
 
     private:
         EVENT_ROUTER& _event_router; // Reference to parent EventRouter
         const std::string _name;
-        std::vector<boost::signals::connection> _connections;
+        const TopicId _topic;
+        connection_list _connections;
     };
     
 
     /**
      * @brief Publish/Subscribe mechanism for sending/receiving events.
      *
+     * Events are identified by name.  Each name is interned into a dense topic
+     * table the first time it is seen and the resulting @c TopicId can be used
+     * with the @c publish, @c deliver, @c subscribe and @c route overloads to
+     * bypass the name lookup entirely.
+     *
+     * Names are hierarchical, with segments separated by '/'.  Subscriptions
+     * and routes may use a pattern, in which a segment of "*" or "**" stands
+     * for any segments (see @c is_topic_pattern), in place of a name.  Patterns are matched against a
+     * topic once, when either the topic or the subscription is created, and
+     * the subscriber is connected directly to the signal of each matching
+     * topic, so publishing to a topic costs the same whether its subscribers
+     * used patterns or exact names.
+     *
+     * A @c MultiThreaded router may be used from any number of threads at
+     * once: events can be published concurrently, and subscriptions made or
+     * removed while events are being delivered.  Resolving a @c TopicId never
+     * takes a lock; resolving a name takes a shared (reader) lock unless the
+     * topic has to be created.  A @c SingleThreaded router takes no locks at
+     * all and must only be used from one thread at a time.
      **/
     class EventRouter {
     protected:
         static void immediate_delivery(EventRouter& router,
-                                       const std::string& name,
-                                       const boost::any value);
+                                       TopicId topic,
+                                       const boost::any& value);
     public:
         /**
          * @brief Get the default instance of the EventRouter.
@@ -211,12 +365,38 @@ namespace j2 {
         static EventRouter* instance();
 
     public:
-        typedef std::tr1::function<void (EventRouter&, const std::string&, const boost::any)> DeliveryPolicy;
+        typedef std::tr1::function<void (EventRouter&, TopicId, const boost::any&)> DeliveryPolicy;
+
+        /** @brief Whether a router may be used from more than one thread at once. */
+        enum ThreadingModel {
+            SingleThreaded,
+            MultiThreaded
+        };
 
     public:
-        EventRouter() : _deliver(immediate_delivery) { }
+        EventRouter(ThreadingModel model = SingleThreaded) :
+            _topic_count(0),
+            _deliver(immediate_delivery),
+            _immediate(true),
+            _concurrent(model == MultiThreaded) {
+            std::fill(_chunks, _chunks + MAX_TOPIC_CHUNKS, (Topic**)0);
+        }
        
-        EventRouter(DeliveryPolicy policy) : _deliver(policy) { }
+        EventRouter(DeliveryPolicy policy, ThreadingModel model = SingleThreaded) :
+            _topic_count(0),
+            _deliver(policy),
+            _immediate(false),
+            _concurrent(model == MultiThreaded) {
+            std::fill(_chunks, _chunks + MAX_TOPIC_CHUNKS, (Topic**)0);
+        }
+
+        ~EventRouter();
+
+        /** @brief Whether events are delivered as soon as they are published. */
+        bool is_immediate() const { return _immediate; }
+
+        /** @brief Whether this router may be used from multiple threads. */
+        bool is_concurrent() const { return _concurrent; }
 
         /**
          * @brief Publish an event of the given name with a value according to the
@@ -225,8 +405,19 @@ namespace j2 {
          * @param name name of the event
          * @param value value (must match type used in subscription).
          */
-        void publish(const std::string& name, const boost::any value) {
-            _deliver(*this, name, value);
+        void publish(const std::string& name, const boost::any& value) {
+            _deliver(*this, topic(name), value);
+        }
+
+        /**
+         * @brief Publish an event on an interned topic with a value according to
+         * the configured publication policy.
+         *
+         * @param topic handle obtained from @c topic
+         * @param value value (must match type used in subscription).
+         */
+        void publish(TopicId topic, const boost::any& value) {
+            _deliver(*this, topic, value);
         }
 
         /**
@@ -236,12 +427,51 @@ namespace j2 {
          * @param name name of the event
          * @param value value (must match type used in subscription).
          */
-        void deliver(const std::string& name, const boost::any value);
+        void deliver(const std::string& name, const boost::any& value) {
+            deliver(topic(name), value);
+        }
+
+        /**
+         * @brief Deliver an event on an interned topic with a value.
+         *
+         * @param topic handle obtained from @c topic
+         * @param value value (must match type used in subscription).
+         */
+        void deliver(TopicId topic, const boost::any& value) {
+            const Topic& entry = topic_entry(topic);
+            (*entry.signal)(entry.name, value);
+            ChannelBase* channel = entry.channel.load(boost::memory_order_acquire);
+            if (channel) channel->deliver(value);
+        }
+
+        /**
+         * @brief Deliver a typed value on an interned topic.
+         *
+         * The value is passed by reference to the subscribers of the topic's
+         * @c Channel and is only boxed into a @c boost::any if the topic also
+         * has untyped subscribers.
+         *
+         * @param topic handle obtained from @c topic
+         * @param value value (must match type used in subscription).
+         */
+        template <typename T>
+        void deliver_value(TopicId topic, const T& value);
+
+        /**
+         * @brief Deliver a typed value to the untyped subscribers of an
+         * interned topic only, boxing it only if there are any.  Used by a
+         * @c Channel, which calls its typed subscribers itself.
+         */
+        template <typename T>
+        void deliver_untyped(TopicId topic, const T& value) {
+            const Topic& entry = topic_entry(topic);
+            if (!entry.signal->empty()) (*entry.signal)(entry.name, boost::any(value));
+        }
 
 
         /**
          * @brief Create a subcription for a given event.
-         * @param name name of event to subscribe to
+         * @param name name of event, or topic pattern, to subscribe to
          * @return a @c Subscription object that can be bound to callbacks or
          *  pointer values
          **/
@@ -250,6 +480,53 @@ namespace j2 {
             return Subscription<T, EventRouter>(*this, name);
         }
 
+        /**
+         * @brief Create a subcription for an interned topic.
+         * @param topic handle obtained from @c topic
+         * @return a @c Subscription object that can be bound to callbacks or
+         *  pointer values
+         **/
+        template <typename T>
+        Subscription<T> subscribe(TopicId topic) {
+            return Subscription<T, EventRouter>(*this, topic);
+        }
+
+        /**
+         * @brief Obtain a statically typed channel for a given event.
+         *
+         * Values published on the channel are passed by reference straight to
+         * the channel's typed subscribers, without being boxed into a
+         * @c boost::any.  Untyped subscribers to the same event continue to
+         * work: values are only boxed for them when any are connected, and
+         * events published through the untyped @c publish are cast and
+         * delivered to the typed subscribers.
+         *
+         * A topic may only have channels of a single type.
+         *
+         * @param name name of the event
+         * @return a @c Channel that can be used to publish or subscribe
+         * @throws std::invalid_argument if the topic already has a channel of
+         *  a different type
+         **/
+        template <typename T>
+        Channel<T> channel(const std::string& name) {
+            return channel<T>(topic(name));
+        }
+
+        /**
+         * @brief Obtain a statically typed channel for an interned topic.
+         * @see channel(const std::string&)
+         **/
+        template <typename T>
+        Channel<T> channel(TopicId topic);
+
+        /**
+         * @brief As @c channel, but empty rather than throwing if the topic
+         * already has a channel of a different type.
+         **/
+        template <typename T>
+        boost::optional< Channel<T> > try_channel(TopicId topic);
+
         /**
          * @brief Route messages for the given name to the destination event router.
          *
@@ -257,82 +534,1111 @@ namespace j2 {
          * two @c EventRouters.  Events published on one @c EventRouter are automatically
          * published on the other.
          *
-         * @param name name of event to route
+         * @param name name of event, or topic pattern, to route
          * @param dest destimation event router
          * @return a @c Subscription object that can be used to unsubscribe from routed
          * events.
          */
-        Subscription<> route(const std::string& name, EventRouter& dest) {
-            return subscribe(name, 
-                             boost::bind<void>(&EventRouter::publish,
-                                               boost::ref(dest), _1, _2));
-        }
+        Subscription<> route(const std::string& name, EventRouter& dest);
+
+        /**
+         * @brief Route messages for an interned topic to a topic on the destination
+         * event router.
+         *
+         * @param source handle of the topic on this router
+         * @param dest destination event router
+         * @param dest_topic handle of the topic on @c dest
+         * @return a @c Subscription object that can be used to unsubscribe from routed
+         * events.
+         */
+        Subscription<> route(TopicId source, EventRouter& dest, TopicId dest_topic);
 
         /**
          * @brief Create a subcription for a given event with a generic callback
-         * @param name of event to subscribe to
+         * @param name of event, or topic pattern, to subscribe to
          * @return a @c Subscription object bound to the generic callback
          **/
         Subscription<> subscribe(const std::string& name,
                                  std::tr1::function<void (const std::string&,
-                                                          const boost::any)> callback);
+                                                          const boost::any&)> callback);
+
+        /**
+         * @brief Create a subcription for an interned topic with a generic callback
+         * @param topic handle obtained from @c topic
+         * @return a @c Subscription object bound to the generic callback
+         **/
+        Subscription<> subscribe(TopicId topic,
+                                 std::tr1::function<void (const std::string&,
+                                                          const boost::any&)> callback);
+
+        /**
+         * @brief Return the interned handle for the named topic, creating the topic
+         * if it does not already exist.
+         * @param name name of the event
+         * @return handle that remains valid for the lifetime of this router
+         * @throws std::invalid_argument if @c name is a topic pattern
+         **/
+        TopicId topic(const std::string& name);
 
         /**
-         * @brief Return the boost signal used for event delivery for the corresponding name.
+         * @brief Return the name an interned topic was created with.
+         * @param topic handle obtained from @c topic
+         **/
+        const std::string& topic_name(TopicId topic) const {
+            return topic_entry(topic).name;
+        }
+
+        /** @brief Number of topics interned by this router. */
+        std::size_t topic_count() const { return _topic_count; }
+
+        /**
+         * @brief Return the signal used for event delivery for the corresponding name.
          * @param name of event to subscribe to
-         * @return a @c boost::signal
+         * @return a @c Signal
+         **/
+        const SignalPtr& signal_for(const std::string& name) {
+            return signal_for(topic(name));
+        }
+
+        /**
+         * @brief Return the signal used for event delivery for an interned topic.
+         * @param topic handle obtained from @c topic
+         * @return a @c Signal
          **/
-        SignalPtr signal_for(const std::string& name);
+        const SignalPtr& signal_for(TopicId topic) {
+            return topic_entry(topic).signal;
+        }
+
+        /**
+         * @brief Connect a delegate to the signal of every topic matching a
+         * pattern, including topics created later.
+         * @param pattern topic pattern (see @c is_topic_pattern)
+         * @param delegate delegate to connect
+         * @return a @c Connection that blocks or disconnects the delegate on
+         *  every matching topic
+         **/
+        Connection connect_pattern(const std::string& pattern, const SignalDelegate& delegate);
+
+        /** @brief Makes the delegate connected to a topic matching a pattern. */
+        typedef std::tr1::function<SignalDelegate (const std::string& topic)> PatternDelegateFactory;
+
+        /**
+         * @brief As @c connect_pattern, but connect a delegate made for each
+         * matching topic by @c make_delegate.  It is called with this
+         * router's topic lock held, so must not create topics on this router.
+         **/
+        Connection connect_pattern_with(const std::string& pattern,
+                                        const PatternDelegateFactory& make_delegate);
 
     private:
         static EventRouter* default_instance; 
 
+        static void create_default_instance();
+
     private:
-        std::tr1::unordered_map<std::string, SignalPtr> _subscriptions;
+        // Not copyable
+        EventRouter(const EventRouter&);
+        EventRouter& operator=(const EventRouter&);
+
+        // Delegates subscribed to a topic pattern.  A delegate is made for
+        // and connected to the signal of each matching topic; connections to
+        // the pattern refer to this object so that they apply to all of those
+        // signals.
+        class PatternSlot : public ConnectionTarget,
+                            public std::tr1::enable_shared_from_this<PatternSlot> {
+        public:
+            PatternSlot(EventRouter& router,
+                        const std::string& pattern,
+                        const PatternDelegateFactory& make_delegate) :
+                _router(router),
+                _pattern(pattern),
+                _make_delegate(make_delegate),
+                _blocked(false),
+                _connected(true) { }
+
+            const std::string& pattern() const { return _pattern; }
+
+            // Connect to the signal of a newly matched topic; called with the
+            // router's topic lock held
+            void attach(const std::string& name, const SignalPtr& signal);
+
+            void block(unsigned id, bool blocked);
+
+            void disconnect(unsigned id);
+
+            bool connected(unsigned id) const;
+
+        private:
+            EventRouter& _router;
+            const std::string _pattern;
+            const PatternDelegateFactory _make_delegate;
+            std::vector<Connection> _connections;
+            bool _blocked;
+            bool _connected;
+        };
+
+        typedef std::tr1::shared_ptr<PatternSlot> PatternSlotPtr;
+
+        // Entry in the topic table
+        struct Topic {
+            Topic(const std::string& name, bool concurrent) :
+                name(name),
+                signal(new Signal(concurrent)),
+                channel(0) { }
+
+            const std::string name;
+            const SignalPtr signal;
+            boost::atomic<ChannelBase*> channel; // Set once a typed channel is requested
+            ChannelPtr channel_owner;
+        };
+
+        // Topics are allocated individually and indexed through fixed size
+        // chunks that never move.  A TopicId can therefore be resolved without
+        // locking while other threads add topics, and references to a topic
+        // (in particular the name passed to subscribers) stay valid.
+        static const std::size_t TOPIC_CHUNK_BITS = 8;
+        static const std::size_t TOPIC_CHUNK_SIZE = 1 << TOPIC_CHUNK_BITS;
+        static const std::size_t MAX_TOPIC_CHUNKS = 256;
+
+        Topic& topic_entry(TopicId topic) const {
+            return *_chunks[topic >> TOPIC_CHUNK_BITS][topic & (TOPIC_CHUNK_SIZE - 1)];
+        }
+
+        typedef boost::shared_mutex TopicMutex;
+
+        Topic** _chunks[MAX_TOPIC_CHUNKS];
+        boost::atomic<std::size_t> _topic_count;
+        std::tr1::unordered_map<std::string, TopicId> _topic_ids;
+        TopicTrie<PatternSlotPtr> _patterns;
+        mutable TopicMutex _topic_mutex;    // Guards _topic_ids, _patterns and topic creation
         DeliveryPolicy _deliver;
+        bool _immediate;
+        const bool _concurrent;
     };
 
     inline void EventRouter::immediate_delivery(EventRouter& router,
-                                                const std::string& name,
-                                                const boost::any value) {
-        router.deliver(name, value);
+                                                TopicId topic,
+                                                const boost::any& value) {
+        router.deliver(topic, value);
     }
 
-    class Event {
+    // Callback used by EventRouter::route to republish an event on a
+    // topic that has already been resolved on the destination router.
+    class RouteForwarder {
     public:
-        Event(EventRouter& router, const std::string& name, const boost::any value) :
-            _router(router),
-            _name(name),
-            _value(value) { }
-        
-        void deliver() {
-            _router.deliver(_name, _value);
+        RouteForwarder(EventRouter& dest, TopicId topic) :
+            _dest(&dest),
+            _topic(topic) { }
+
+        void operator()(const std::string&, const boost::any& value) const {
+            _dest->publish(_topic, value);
         }
 
     private:
-        EventRouter& _router;
-        const std::string _name;
-        const boost::any _value;            
+        EventRouter* _dest;
+        TopicId _topic;
+    };
+
+    // Makes the forwarder republishing each topic matching a routed pattern
+    // under the same name on another router.  The destination topic is
+    // resolved once, when the topic is matched, rather than for every event.
+    class PatternRouteForwarder {
+    public:
+        PatternRouteForwarder(EventRouter& dest) : _dest(&dest) { }
+
+        SignalDelegate operator()(const std::string& name) const {
+            return RouteForwarder(*_dest, _dest->topic(name));
+        }
+
+    private:
+        EventRouter* _dest;
+    };
+
+    inline Subscription<> EventRouter::route(TopicId source,
+                                             EventRouter& dest,
+                                             TopicId dest_topic) {
+        return subscribe(source, RouteForwarder(dest, dest_topic));
+    }
+
+    inline Subscription<> EventRouter::route(const std::string& name, EventRouter& dest) {
+        if (is_topic_pattern(name)) {
+            // Matching topics are created on the destination with our topic
+            // lock held, which would deadlock on ourselves
+            if (&dest == this) throw std::invalid_argument("Cannot route pattern " + name + " to its own router");
+            return Subscription<>(*this, name, connect_pattern_with(name, PatternRouteForwarder(dest)));
+        }
+        return route(topic(name), dest, dest.topic(name));
+    }
+
+    /**
+     * @brief Statically typed handle for publishing and subscribing to an event.
+     *
+     * Obtained from @c EventRouter::channel.  When the router delivers
+     * immediately, publishing a value passes a @c const reference straight
+     * to the typed subscribers, with no check of the topic's channel type;
+     * the value is only boxed into a @c boost::any if untyped subscribers
+     * (including routes to other routers) exist.
+     * Routers with a queueing @c DeliveryPolicy always receive the boxed
+     * value so that delivery order is preserved.
+     *
+     * @tparam T type of the event
+     */
+    template <typename T>
+    class Channel {
+    public:
+        Channel(EventRouter& router,
+                TopicId topic,
+                std::tr1::shared_ptr< ChannelSignal<T> > signal) :
+            _router(&router),
+            _topic(topic),
+            _signal(signal) { }
+
+        /** @brief The interned handle of the event. */
+        TopicId topic() const { return _topic; }
+
+        /** @brief The name of the event. */
+        const std::string& name() const { return _router->topic_name(_topic); }
+
+        /**
+         * @brief Publish a value on this channel.
+         * @param value value to publish
+         */
+        void publish(const T& value) const {
+            if (!_router->is_immediate()) {
+                _router->publish(_topic, boost::any(value));
+                return;
+            }
+            (*_signal)(value);
+            _router->deliver_untyped(_topic, value);
+        }
+
+        /** 
+         * @brief When events are received call the given callback function.
+         * @param func callback function to invoke
+         * @return a @c Subscription for the callback
+         **/
+        Subscription<T> deliver_with(std::tr1::function<void (const T&)> func) {
+            return Subscription<T>(*_router, _topic, _signal->connect(func));
+        }
+
+        /** 
+         * @brief When events are received, assign the result to the given pointer.
+         * @param ptr pointer to assign result to
+         * @return a @c Subscription for the assignment
+         **/
+        Subscription<T> assign_to(T* ptr) {
+            return Subscription<T>(*_router, _topic,
+                                   _signal->connect(ASSIGN_TO<T, T*>(ptr)));
+        }
+
+        /**
+         * @brief Pass values published untyped with a type other than @c T
+         * to the given callback, instead of the cast failing in the publisher.
+         * @param func callback function to invoke with the boxed value
+         * @return a @c Subscription for the callback
+         **/
+        Subscription<T> deliver_mismatched_with(std::tr1::function<void (const boost::any&)> func) {
+            return Subscription<T>(*_router, _topic, _signal->mismatched()->connect(func));
+        }
+
+    private:
+        EventRouter* _router;
+        TopicId _topic;
+        std::tr1::shared_ptr< ChannelSignal<T> > _signal;
     };
 
+    template <typename T>
+    void EventRouter::deliver_value(TopicId topic, const T& value) {
+        const Topic& entry = topic_entry(topic);
+        ChannelBase* channel = entry.channel.load(boost::memory_order_acquire);
+        if (channel) {
+            if (channel->type() == typeid(T)) {
+                (*static_cast< ChannelSignal<T>* >(channel))(value);
+            } else {
+                channel->deliver(boost::any(value));
+            }
+        }
+        deliver_untyped(topic, value);
+    }
+
+    template <typename T>
+    Channel<T> EventRouter::channel(TopicId topic) {
+        boost::optional< Channel<T> > result = try_channel<T>(topic);
+        if (!result) {
+            throw std::invalid_argument("Channel type mismatch for " + topic_name(topic));
+        }
+        return *result;
+    }
+
+    template <typename T>
+    boost::optional< Channel<T> > EventRouter::try_channel(TopicId topic) {
+        Topic& entry = topic_entry(topic);
+        boost::unique_lock<TopicMutex> lock(_topic_mutex, boost::defer_lock);
+        if (_concurrent) lock.lock();
+        if (!entry.channel_owner) {
+            ChannelSignal<T>* channel = new ChannelSignal<T>(_concurrent);
+            entry.channel_owner = ChannelPtr(channel);
+            entry.channel.store(channel, boost::memory_order_release);
+        }
+        std::tr1::shared_ptr< ChannelSignal<T> > signal =
+            std::tr1::dynamic_pointer_cast< ChannelSignal<T> >(entry.channel_owner);
+        if (!signal) return boost::optional< Channel<T> >();
+        return Channel<T>(*this, topic, signal);
+    }
+
+    /** @brief Size in bytes of the buffer used to store an @c EventPayload inline. */
+    const std::size_t EVENT_INLINE_SIZE = 4 * sizeof(void*);
+
+    /** @brief Initial capacity of an @c EventQueue. */
+    const std::size_t DEFAULT_EVENT_QUEUE_CAPACITY = 256;
+
+    /**
+     * @brief Value of a queued event.
+     *
+     * Values that fit in @c EVENT_INLINE_SIZE bytes are constructed in place,
+     * larger ones are allocated.  Values enqueued through the untyped
+     * interface are held as a @c boost::any.  Moving a payload between
+     * buffers copies an inline value, and swaps a @c boost::any, so it does
+     * not allocate.
+     */
+    class EventPayload {
+    public:
+        EventPayload() : _ops(0) { }
+
+        ~EventPayload() { clear(); }
+
+        bool empty() const { return _ops == 0; }
+
+        /** @brief Replace the payload with a typed value. */
+        template <typename T>
+        void assign(const T& value) {
+            clear();
+            Store<T>::create(_buffer, value);
+            _ops = Store<T>::ops();
+        }
+
+        /** @brief Replace the payload with a boxed value. */
+        void assign(const boost::any& value) {
+            clear();
+            new (_buffer.address()) boost::any(value);
+            _ops = any_ops();
+        }
+
+        /** @brief Move the payload to @c to, leaving this payload empty. */
+        void move_to(EventPayload& to) {
+            to.clear();
+            if (!_ops) return;
+            _ops->move(_buffer, to._buffer);
+            to._ops = _ops;
+            _ops = 0;
+        }
+
+        /** @brief Deliver the payload on a topic of @c router. */
+        void deliver(EventRouter& router, TopicId topic) const {
+            _ops->deliver(router, topic, _buffer);
+        }
+
+        void clear() {
+            if (!_ops) return;
+            _ops->destroy(_buffer);
+            _ops = 0;
+        }
+
+    private:
+        // Not copyable
+        EventPayload(const EventPayload&);
+        EventPayload& operator=(const EventPayload&);
+
+        typedef boost::aligned_storage<EVENT_INLINE_SIZE>::type Buffer;
+
+        struct Ops {
+            void (*move)(Buffer& from, Buffer& to);
+            void (*destroy)(Buffer& buffer);
+            void (*deliver)(EventRouter& router, TopicId topic, const Buffer& buffer);
+        };
+
+        template <typename T>
+        struct FitsInline {
+            static const bool value =
+                sizeof(T) <= sizeof(Buffer) &&
+                boost::alignment_of<T>::value <= boost::alignment_of<Buffer>::value;
+        };
+
+        // Value stored inline in the buffer
+        template <typename T, bool INLINE = FitsInline<T>::value>
+        struct Store {
+            static void create(Buffer& buffer, const T& value) {
+                new (buffer.address()) T(value);
+            }
+
+            static const T& get(const Buffer& buffer) {
+                return *static_cast<const T*>(buffer.address());
+            }
+
+            static void move(Buffer& from, Buffer& to) {
+                create(to, get(from));
+                destroy(from);
+            }
+
+            static void destroy(Buffer& buffer) {
+                static_cast<T*>(buffer.address())->~T();
+            }
+
+            static void deliver(EventRouter& router, TopicId topic, const Buffer& buffer);
+
+            static const Ops* ops() {
+                static const Ops ops = { &move, &destroy, &deliver };
+                return &ops;
+            }
+        };
+
+        // Value too large for the buffer, which holds a pointer to it instead
+        template <typename T>
+        struct Store<T, false> {
+            static void create(Buffer& buffer, const T& value) {
+                *static_cast<T**>(buffer.address()) = new T(value);
+            }
+
+            static const T& get(const Buffer& buffer) {
+                return **static_cast<T* const*>(buffer.address());
+            }
+
+            static void move(Buffer& from, Buffer& to) {
+                *static_cast<T**>(to.address()) = *static_cast<T**>(from.address());
+            }
+
+            static void destroy(Buffer& buffer) {
+                delete *static_cast<T**>(buffer.address());
+            }
+
+            static void deliver(EventRouter& router, TopicId topic, const Buffer& buffer);
+
+            static const Ops* ops() {
+                static const Ops ops = { &move, &destroy, &deliver };
+                return &ops;
+            }
+        };
+
+        static boost::any& any_value(Buffer& buffer) {
+            return *static_cast<boost::any*>(buffer.address());
+        }
+
+        static void any_move(Buffer& from, Buffer& to) {
+            new (to.address()) boost::any();
+            any_value(to).swap(any_value(from));
+            any_destroy(from);
+        }
+
+        static void any_destroy(Buffer& buffer) {
+            any_value(buffer).~any();
+        }
+
+        static void any_deliver(EventRouter& router, TopicId topic, const Buffer& buffer) {
+            router.deliver(topic, *static_cast<const boost::any*>(buffer.address()));
+        }
+
+        static const Ops* any_ops() {
+            static const Ops ops = { &any_move, &any_destroy, &any_deliver };
+            return &ops;
+        }
+
+        Buffer _buffer;
+        const Ops* _ops;
+    };
+
+    template <typename T, bool INLINE>
+    void EventPayload::Store<T, INLINE>::deliver(EventRouter& router,
+                                                 TopicId topic,
+                                                 const Buffer& buffer) {
+        router.deliver_value(topic, get(buffer));
+    }
+
+    template <typename T>
+    void EventPayload::Store<T, false>::deliver(EventRouter& router,
+                                                TopicId topic,
+                                                const Buffer& buffer) {
+        router.deliver_value(topic, get(buffer));
+    }
+
+    /**
+     * @brief How an @c EventQueue treats successive events on the same topic.
+     */
+    enum QueueMode {
+        QueueAll,   ///< Every event is delivered, in order
+        Conflate    ///< Only the latest value of a topic is kept until delivered
+    };
+
+    /**
+     * @brief What an @c EventQueue does with an event that arrives when it
+     * is full.
+     */
+    enum OverflowPolicy {
+        Grow,               ///< Grow the queue, which is then unbounded
+        DropOldest,         ///< Discard the oldest queued event to make room
+        DropNewest,         ///< Discard the arriving event
+        BlockProducer,      ///< Wait until the consumer makes room
+        SpillToConflate     ///< Hold the latest overflowing value of each topic
+    };
+
+    /** @brief Counters kept by an @c EventQueue. */
+    struct QueueStats {
+        QueueStats() : size(0), high_water_mark(0), dropped(0), blocked(0), spilled(0) { }
+        std::size_t size;               ///< Events currently queued
+        std::size_t high_water_mark;    ///< Most events queued at once
+        std::size_t dropped;            ///< Events discarded by DropOldest or DropNewest
+        std::size_t blocked;            ///< Producers made to wait by BlockProducer
+        std::size_t spilled;            ///< Events held by SpillToConflate
+    };
+
+    /**
+     * @brief Priority of the events on a topic.  Each priority has its own
+     * lane in an @c EventQueue, and higher priority lanes are delivered first.
+     */
+    enum EventPriority {
+        HighPriority,       ///< Alarms and control events
+        NormalPriority,
+        LowPriority         ///< Bulk telemetry
+    };
+
+    /** @brief Number of @c EventPriority lanes in an @c EventQueue. */
+    const std::size_t EVENT_PRIORITY_LANES = 3;
+
+    /**
+     * @brief Default number of times a non-empty lane may be passed over in
+     * favour of higher priority lanes before one of its events is delivered.
+     */
+    const std::size_t DEFAULT_STARVATION_LIMIT = 16;
+
+    /**
+     * @brief Clock used to timestamp events, timers and deadlines; follows
+     * a simulated clock when one is installed.
+     */
+    typedef Clock EventClock;
+
+    /** @brief Queue latency of the events delivered from one lane of an @c EventQueue. */
+    struct LaneStats {
+        LaneStats() : delivered(0), total_latency(0), max_latency(0) { }
+
+        /** @brief Mean time delivered events spent queued. */
+        EventClock::duration mean_latency() const {
+            if (delivered == 0) return EventClock::duration(0);
+            return total_latency / EventClock::rep(delivered);
+        }
+
+        std::size_t delivered;                  ///< Events delivered from the lane
+        EventClock::duration total_latency;     ///< Sum of time spent queued
+        EventClock::duration max_latency;       ///< Longest time spent queued
+    };
+
+    class EventQueue;
+
+    /** @brief Maximum number of listeners on one @c EventQueue. */
+    const std::size_t MAX_READY_LISTENERS = 4;
+
+    /**
+     * @brief Interface for objects told when an @c EventQueue becomes
+     * non-empty, such as a scheduler running the queue's module.
+     */
+    class ReadyListener {
+    public:
+        virtual ~ReadyListener() { }
+
+        /**
+         * @brief Called, without the queue's lock held, by the thread whose
+         * event made @c queue non-empty.  Must not throw, nor remove a
+         * listener from @c queue.
+         */
+        virtual void ready(EventQueue& queue) = 0;
+    };
+
+    /** @brief Slot in an @c EventQueue. */
+    struct Event {
+        Event() : router(0), topic(0), conflated(false) { }
+
+        EventRouter* router;
+        TopicId topic;
+        bool conflated;         // Value is held by the topic's conflation state
+        EventClock::time_point enqueued;
+        EventPayload payload;
+
+    private:
+        // Not copyable
+        Event(const Event&);
+        Event& operator=(const Event&);
+    };
+
+    /**
+     * @brief Queue of events awaiting delivery.
+     *
+     * Events may be enqueued from any number of threads, but the queue must
+     * only be drained (by @c deliver) from one thread at a time.
+     *
+     * Events are held in power-of-two rings of slots allocated up front, one
+     * for each @c EventPriority lane.  Topics are stored as @c TopicId and
+     * values as an inline @c EventPayload, so once the rings are large enough
+     * enqueueing and delivering an event allocates nothing: values given to
+     * @c enqueue_value are delivered to the topic's typed @c Channel without
+     * ever being boxed, unless the topic also has untyped subscribers.
+     *
+     * @c deliver takes the oldest event from the highest priority non-empty
+     * lane, except that a lane which has been passed over more than the
+     * starvation limit times in a row is served next, so low priority topics
+     * keep moving during a burst of high priority ones.  The time each event
+     * waits is recorded per lane (see @c lane_stats).
+     *
+     * By default a full ring doubles in size; @c high_water_mark reports the
+     * most events held at once so that the initial capacity can be tuned.
+     * @c set_capacity bounds the total number of events in all lanes instead,
+     * with an @c OverflowPolicy deciding what happens to events that arrive
+     * while the queue is full.  @c DropOldest discards the oldest event of the
+     * lowest priority non-empty lane.  With @c BlockProducer the thread
+     * draining the queue must never publish to it, or it will deadlock once
+     * the queue fills.  With @c SpillToConflate overflowing events are
+     * conflated per topic (see below) and delivered in order of first
+     * overflow once there is room, so memory is bounded by the capacity plus
+     * the number of topics.  Until a topic's spilled event is delivered its
+     * later events are conflated into it too, even once there is room, so
+     * that the topic is never delivered out of order.
+     *
+     * Topics are queued according to a @c QueueMode.  A @c Conflate topic
+     * holds at most one event in the queue: publishing while it is pending
+     * replaces the pending value in place, and the event is delivered at the
+     * position of the first publication with the newest value.  Per-topic
+     * state is indexed by @c TopicId, so a queue with conflated topics or
+     * topic priorities should only serve a single router.
+     */
     class EventQueue {
     public:
-        void enqueue(EventRouter& router, const std::string& name, const boost::any& value) {
-            _queue.push(Event(router, name, value));
+        EventQueue(QueueMode mode = QueueAll,
+                   std::size_t capacity = DEFAULT_EVENT_QUEUE_CAPACITY) :
+            _size(0),
+            _limit(std::size_t(-1)),
+            _overflow(Grow),
+            _starvation_limit(DEFAULT_STARVATION_LIMIT),
+            _default_mode(mode),
+            _listener_count(0),
+            _notifying(0),
+            _histogram(0) {
+            for (std::size_t i = 0; i < EVENT_PRIORITY_LANES; i++) {
+                _lanes[i].reserve(capacity);
+            }
+        }
+
+        /**
+         * @brief Bound the number of events the queue holds.
+         * @param capacity maximum number of events, ignored for @c Grow
+         * @param policy what to do with events arriving while the queue is full
+         */
+        void set_capacity(std::size_t capacity, OverflowPolicy policy) {
+            boost::mutex::scoped_lock lock(_mutex);
+            _overflow = policy;
+            _limit = policy == Grow ? std::size_t(-1) : std::max(capacity, std::size_t(1));
+            unspill();
+            _not_full.notify_all();
+        }
+
+        /**
+         * @brief Add a listener told when the queue becomes non-empty.  Adding
+         * a listener already added has no effect.
+         * @throws std::length_error if @c MAX_READY_LISTENERS are added
+         */
+        void add_ready_listener(ReadyListener* listener) {
+            boost::mutex::scoped_lock lock(_mutex);
+            for (std::size_t i = 0; i < _listener_count; i++) {
+                if (_listeners[i] == listener) return;
+            }
+            if (_listener_count == MAX_READY_LISTENERS) {
+                throw std::length_error("too many event queue listeners");
+            }
+            _listeners[_listener_count++] = listener;
+        }
+
+        /**
+         * @brief Record the time each delivered event spent queued into
+         * @c histogram, or stop recording by passing 0.
+         */
+        void set_latency_histogram(LatencyHistogram* histogram) {
+            boost::mutex::scoped_lock lock(_mutex);
+            _histogram = histogram;
+        }
+
+        /**
+         * @brief Remove a listener.  Waits for listeners already being told
+         * the queue is ready, so the listener may be destroyed on return.
+         */
+        void remove_ready_listener(ReadyListener* listener) {
+            boost::mutex::scoped_lock lock(_mutex);
+            ReadyListener** end = std::remove(_listeners, _listeners + _listener_count, listener);
+            _listener_count = end - _listeners;
+            while (_notifying > 0) _notified.wait(lock);
+        }
+
+        /** @brief Set the mode of topics that have not been given one. */
+        void set_default_mode(QueueMode mode) {
+            boost::mutex::scoped_lock lock(_mutex);
+            _default_mode = mode;
+        }
+
+        /** @brief Set the mode used for a topic, overriding the default. */
+        void set_mode(TopicId topic, QueueMode mode) {
+            boost::mutex::scoped_lock lock(_mutex);
+            TopicState& state = topic_state(topic);
+            state.mode = mode;
+            state.has_mode = true;
+        }
+
+        /** @brief The mode used for a topic. */
+        QueueMode mode(TopicId topic) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return mode_for(topic);
+        }
+
+        /** @brief Set the priority of a topic, which is @c NormalPriority by default. */
+        void set_priority(TopicId topic, EventPriority priority) {
+            boost::mutex::scoped_lock lock(_mutex);
+            topic_state(topic).priority = priority;
+        }
+
+        /** @brief The priority of a topic. */
+        EventPriority priority(TopicId topic) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return priority_for(topic);
+        }
+
+        /**
+         * @brief Set how many times in a row a non-empty lane may be passed
+         * over before one of its events is delivered.
+         */
+        void set_starvation_limit(std::size_t limit) {
+            boost::mutex::scoped_lock lock(_mutex);
+            _starvation_limit = limit;
+        }
+
+        /** @brief Enqueue a boxed value for delivery on a topic of @c router. */
+        void enqueue(EventRouter& router, TopicId topic, const boost::any& value) {
+            enqueue_value(router, topic, value);
+        }
+
+        /** @brief Enqueue a typed value for delivery on a topic of @c router. */
+        template <typename T>
+        void enqueue_value(EventRouter& router, TopicId topic, const T& value) {
+            EventClock::time_point now = EventClock::now();
+            boost::mutex::scoped_lock lock(_mutex);
+            bool waited = false;
+            for (;;) {
+                bool conflate = mode_for(topic) == Conflate;
+                // Fold into a queued conflated or spilled event of the topic,
+                // whatever its mode, so that its events stay in order
+                if (pending(topic)) {
+                    _topics[topic]->latest.assign(value);
+                    if (!conflate) _stats.spilled++;
+                    return;
+                }
+                if (!full()) {
+                    Event& event = push(router, topic, now);
+                    if (conflate) {
+                        TopicState& state = topic_state(topic);
+                        state.latest.assign(value);
+                        state.pending = true;
+                        event.conflated = true;
+                    } else {
+                        event.payload.assign(value);
+                    }
+                    if (_size > 1 || _listener_count == 0) return;
+                    // Tell the listeners without holding the lock, so that they
+                    // may look at the queue
+                    ReadyListener* listeners[MAX_READY_LISTENERS];
+                    std::size_t count = _listener_count;
+                    std::copy(_listeners, _listeners + count, listeners);
+                    _notifying++;
+                    lock.unlock();
+                    for (std::size_t i = 0; i < count; i++) listeners[i]->ready(*this);
+                    lock.lock();
+                    if (--_notifying == 0) _notified.notify_all();
+                    return;
+                }
+                switch (_overflow) {
+                case Grow:
+                    break;
+                case DropOldest:
+                    drop_oldest();
+                    _stats.dropped++;
+                    break;
+                case DropNewest:
+                    _stats.dropped++;
+                    return;
+                case BlockProducer:
+                    if (!waited) _stats.blocked++;
+                    waited = true;
+                    _not_full.wait(lock);
+                    break;
+                case SpillToConflate:
+                    spill(router, topic, now).assign(value);
+                    return;
+                }
+            }
         }
 
         bool deliver() {
-            if (_queue.empty()) return false;
-            _queue.front().deliver();
-            _queue.pop();
+            EventPayload payload;
+            boost::mutex::scoped_lock lock(_mutex);
+            if (_size == 0) return false;
+            Lane& lane = next_lane();
+            Event& event = lane.front();
+            EventRouter& router = *event.router;
+            TopicId topic = event.topic;
+            if (event.conflated) {
+                TopicState& state = *_topics[topic];
+                state.latest.move_to(payload);
+                state.pending = false;
+                event.conflated = false;
+            } else {
+                event.payload.move_to(payload);
+            }
+            EventClock::duration latency = EventClock::now() - event.enqueued;
+            lane.record(latency);
+            if (_histogram) _histogram->record(latency);
+            lane.pop_front();
+            _size--;
+            unspill();
+            _not_full.notify_one();
+            // Deliver unlocked so that subscribers can publish to this queue
+            lock.unlock();
+            payload.deliver(router, topic);
             return true;
         }
         
-        int size() const { return _queue.size(); }
+        int size() const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _size + _spilled.size();
+        }
         
-        bool empty() const { return _queue.empty(); }
+        bool empty() const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _size == 0;
+        }
+
+        /** @brief Number of events a lane can hold without growing. */
+        std::size_t capacity(EventPriority priority = NormalPriority) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return std::min(_lanes[priority].capacity, _limit);
+        }
+
+        /** @brief Most events held by the queue at once. */
+        std::size_t high_water_mark() const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _stats.high_water_mark;
+        }
+
+        /** @brief Snapshot of the queue's counters. */
+        QueueStats stats() const {
+            boost::mutex::scoped_lock lock(_mutex);
+            QueueStats stats = _stats;
+            stats.size = _size + _spilled.size();
+            return stats;
+        }
+
+        /** @brief Snapshot of the latency of events delivered from a lane. */
+        LaneStats lane_stats(EventPriority priority) const {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _lanes[priority].stats;
+        }
+
     private:
-        std::queue<Event>_queue;
+        // Not copyable
+        EventQueue(const EventQueue&);
+        EventQueue& operator=(const EventQueue&);
+
+        struct TopicState {
+            TopicState() :
+                mode(QueueAll),
+                has_mode(false),
+                priority(NormalPriority),
+                pending(false) { }
+
+            QueueMode mode;
+            bool has_mode;          // Whether mode overrides the default
+            EventPriority priority;
+            bool pending;           // Whether a conflated or spilled event is queued
+            EventPayload latest;    // Value for the queued conflated event
+        };
+
+        typedef std::tr1::shared_ptr<TopicState> TopicStatePtr;
+
+        // Ring of events for one priority
+        struct Lane {
+            Lane() : capacity(0), head(0), size(0), passed(0) { }
+
+            Event& front() { return ring[head]; }
+
+            // Claim the slot at the tail of the ring, growing it if full
+            Event& push_back() {
+                if (size == capacity) reserve(capacity * 2);
+                Event& event = ring[(head + size) & (capacity - 1)];
+                size++;
+                return event;
+            }
+
+            void pop_front() {
+                head = (head + 1) & (capacity - 1);
+                size--;
+            }
+
+            void record(EventClock::duration latency) {
+                stats.delivered++;
+                stats.total_latency += latency;
+                if (latency > stats.max_latency) stats.max_latency = latency;
+            }
+
+            // Reallocate the ring to hold at least n events
+            void reserve(std::size_t n) {
+                std::size_t size = 1;
+                while (size < n) size <<= 1;
+                if (size <= capacity) return;
+                boost::scoped_array<Event> grown(new Event[size]);
+                for (std::size_t i = 0; i < this->size; i++) {
+                    Event& from = ring[(head + i) & (capacity - 1)];
+                    Event& to = grown[i];
+                    to.router = from.router;
+                    to.topic = from.topic;
+                    to.conflated = from.conflated;
+                    to.enqueued = from.enqueued;
+                    from.payload.move_to(to.payload);
+                }
+                ring.swap(grown);
+                capacity = size;
+                head = 0;
+            }
+
+            boost::scoped_array<Event> ring;
+            std::size_t capacity;
+            std::size_t head;
+            std::size_t size;
+            std::size_t passed;     // Times passed over while non-empty
+            LaneStats stats;
+        };
+
+        TopicState& topic_state(TopicId topic) {
+            if (topic >= _topics.size()) _topics.resize(topic + 1);
+            if (!_topics[topic]) _topics[topic].reset(new TopicState);
+            return *_topics[topic];
+        }
+
+        QueueMode mode_for(TopicId topic) const {
+            if (topic < _topics.size() && _topics[topic] && _topics[topic]->has_mode) {
+                return _topics[topic]->mode;
+            }
+            return _default_mode;
+        }
+
+        EventPriority priority_for(TopicId topic) const {
+            if (topic < _topics.size() && _topics[topic]) return _topics[topic]->priority;
+            return NormalPriority;
+        }
+
+        bool full() const { return _size >= _limit; }
+
+        bool pending(TopicId topic) const {
+            return topic < _topics.size() && _topics[topic] && _topics[topic]->pending;
+        }
+
+        Event& push(EventRouter& router, TopicId topic, EventClock::time_point enqueued) {
+            Event& event = _lanes[priority_for(topic)].push_back();
+            event.router = &router;
+            event.topic = topic;
+            event.enqueued = enqueued;
+            _size++;
+            if (_size > _stats.high_water_mark) _stats.high_water_mark = _size;
+            return event;
+        }
+
+        // Choose the lane to deliver from, which must exist
+        Lane& next_lane() {
+            std::size_t next = EVENT_PRIORITY_LANES;
+            std::size_t starved = EVENT_PRIORITY_LANES;
+            for (std::size_t i = 0; i < EVENT_PRIORITY_LANES; i++) {
+                Lane& lane = _lanes[i];
+                if (lane.size == 0) continue;
+                if (next == EVENT_PRIORITY_LANES) {
+                    next = i;
+                    continue;
+                }
+                if (++lane.passed > _starvation_limit && starved == EVENT_PRIORITY_LANES) {
+                    starved = i;
+                }
+            }
+            if (starved != EVENT_PRIORITY_LANES) {
+                // The starved lane is served instead, so the first was not passed over
+                next = starved;
+            }
+            _lanes[next].passed = 0;
+            return _lanes[next];
+        }
+
+        // Discard the oldest event of the lowest priority non-empty lane
+        void drop_oldest() {
+            for (std::size_t i = EVENT_PRIORITY_LANES; i-- > 0; ) {
+                Lane& lane = _lanes[i];
+                if (lane.size == 0) continue;
+                Event& event = lane.front();
+                if (event.conflated) {
+                    TopicState& state = *_topics[event.topic];
+                    state.latest.clear();
+                    state.pending = false;
+                    event.conflated = false;
+                } else {
+                    event.payload.clear();
+                }
+                lane.pop_front();
+                _size--;
+                return;
+            }
+        }
+
+        // Hold an overflowing event as the latest value of its topic
+        EventPayload& spill(EventRouter& router, TopicId topic, EventClock::time_point enqueued) {
+            TopicState& state = topic_state(topic);
+            if (!state.pending) {
+                state.pending = true;
+                _spilled.push_back(Spilled(&router, topic, enqueued));
+            }
+            _stats.spilled++;
+            return state.latest;
+        }
+
+        // Move spilled events into their lanes as the queue makes room
+        void unspill() {
+            while (!_spilled.empty() && !full()) {
+                const Spilled& spilled = _spilled.front();
+                push(*spilled.router, spilled.topic, spilled.enqueued).conflated = true;
+                _spilled.pop_front();
+            }
+        }
+
+        struct Spilled {
+            Spilled(EventRouter* router, TopicId topic, EventClock::time_point enqueued) :
+                router(router), topic(topic), enqueued(enqueued) { }
+            EventRouter* router;
+            TopicId topic;
+            EventClock::time_point enqueued;
+        };
+
+        Lane _lanes[EVENT_PRIORITY_LANES];
+        std::size_t _size;          // Events in all lanes
+        std::size_t _limit;
+        OverflowPolicy _overflow;
+        std::size_t _starvation_limit;
+        std::deque<Spilled> _spilled;
+        QueueStats _stats;
+        std::vector<TopicStatePtr> _topics;
+        QueueMode _default_mode;
+        ReadyListener* _listeners[MAX_READY_LISTENERS];
+        std::size_t _listener_count;
+        std::size_t _notifying;     // Producers telling copies of _listeners
+        boost::condition_variable _notified;
+        LatencyHistogram* _histogram;
+        mutable boost::mutex _mutex;
+        boost::condition_variable _not_full;
     };
 
     class QueueingDeliveryPolicy {
@@ -342,15 +1648,36 @@ namespace j2 {
         QueueingDeliveryPolicy(std::tr1::shared_ptr<EventQueue> queue) : _queue(queue) { }
         
         void operator()(EventRouter& router,
-                        const std::string& name,
+                        TopicId topic,
                         const boost::any& value) {
-            _queue->enqueue(router, name, value);
+            _queue->enqueue(router, topic, value);
         }
         
     private:
         std::tr1::shared_ptr< EventQueue > _queue;
     };
 
+    // Enqueue a value delivered to a typed signal for delivery on a topic of
+    // another router.  This is used to route typed events into a Module
+    template <typename T> struct QUEUE_VALUE {
+        QUEUE_VALUE(std::tr1::shared_ptr<EventQueue> queue, EventRouter& router, TopicId topic) :
+            queue(queue), router(&router), topic(topic) { }
+        void operator()(const T& value) const { queue->enqueue_value(*router, topic, value); }
+        std::tr1::shared_ptr<EventQueue> queue;
+        EventRouter* router;
+        TopicId topic;
+    };
+
+    // Queue a boxed value, as it is, for delivery on a topic of another router
+    struct QUEUE_ANY {
+        QUEUE_ANY(std::tr1::shared_ptr<EventQueue> queue, EventRouter& router, TopicId topic) :
+            queue(queue), router(&router), topic(topic) { }
+        void operator()(const boost::any& value) const { queue->enqueue(*router, topic, value); }
+        std::tr1::shared_ptr<EventQueue> queue;
+        EventRouter* router;
+        TopicId topic;
+    };
+
 } // namespace j2
 
 #endif // _EVENT_ROUTER_H
@@ -0,0 +1,102 @@
+#ifndef _JOIN_H
+#define _JOIN_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <tr1/functional>
+#include <Timestamp.h>
+
+namespace j2 {
+
+    /**
+     * @brief Group of timestamped inputs that calls a callback once for each
+     * complete set of new values.
+     *
+     * The callback fires when every member has received a value since the
+     * last firing and the timestamps of those values lie within the
+     * tolerance of each other.  A member whose value is older than the
+     * newest by more than the tolerance is treated as not yet arrived, so
+     * that a lagging sensor waits for its next sample instead of being
+     * combined with the others' newer ones.
+     *
+     * Members are usually bound with @c Module::bind_value, which calls
+     * @c arrived from the module's thread.
+     */
+    class Join {
+    public:
+        typedef std::tr1::function<void ()> Callback;
+
+        Join(Callback callback, Timestampable::Clock::duration tolerance) :
+            _callback(callback),
+            _tolerance(tolerance),
+            _fresh_count(0),
+            _cycles(0),
+            _discarded(0) { }
+
+        /** @brief Add a member whose timestamp is read when values arrive. */
+        std::size_t add(const Timestampable& member) {
+            _members.push_back(&member);
+            _fresh.push_back(false);
+            return _members.size() - 1;
+        }
+
+        /** @brief Record that a member has a new value, firing if the set is complete. */
+        void arrived(std::size_t member) {
+            if (!_fresh[member]) {
+                _fresh[member] = true;
+                _fresh_count++;
+            }
+            if (_fresh_count < _members.size()) return;
+
+            Timestampable::Timestamp newest = Timestampable::Timestamp::min();
+            for (std::size_t i = 0; i < _members.size(); i++) {
+                newest = std::max(newest, _members[i]->timestamp());
+            }
+            for (std::size_t i = 0; i < _members.size(); i++) {
+                if (newest - _members[i]->timestamp() > _tolerance) {
+                    _fresh[i] = false;
+                    _fresh_count--;
+                    _discarded++;
+                }
+            }
+            if (_fresh_count < _members.size()) return;
+
+            std::fill(_fresh.begin(), _fresh.end(), false);
+            _fresh_count = 0;
+            _cycles++;
+            _callback();
+        }
+
+        /** @brief Number of times the callback has fired. */
+        std::size_t cycles() const { return _cycles; }
+
+        /** @brief Number of values dropped for being too old to join the others. */
+        std::size_t discarded() const { return _discarded; }
+
+    private:
+        Callback _callback;
+        Timestampable::Clock::duration _tolerance;
+        std::vector<const Timestampable*> _members;
+        std::vector<bool> _fresh;
+        std::size_t _fresh_count;
+        std::size_t _cycles;
+        std::size_t _discarded;
+    };
+
+    /** @brief Assign a value to a member of a @c Join and tell the join. */
+    template <typename T> struct JOIN_VALUE {
+        JOIN_VALUE(T* value, Join& join, std::size_t member) :
+            value(value), join(&join), member(member) { }
+        void operator()(const T& arrived) const {
+            *value = arrived;
+            join->arrived(member);
+        }
+        T* value;
+        Join* join;
+        std::size_t member;
+    };
+
+} // namespace j2
+
+#endif // _JOIN_H
@@ -1,45 +1,205 @@
 #include <tr1/memory>
 #include <boost/function.hpp>
+#include <boost/optional.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
 
 #ifndef _MODULE_H
 #define _MODULE_H
 
 #include <EventRouter.h>
+#include <Join.h>
+#include <TimestampedHistory.h>
 
 namespace j2 {
 
+    /** @brief Topic of a module's local router carrying tasks given to @c Module::post. */
+    const std::string MODULE_POST_TOPIC = "/module/post";
+
     class Module {        
     public:
+        /** @brief Work run on a module's queue. */
+        typedef std::tr1::function<void ()> Task;
+
         Module(EventRouter* central=EventRouter::instance()) :
             _central(central), 
             _queue(new EventQueue), 
-            _local(QueueingDeliveryPolicy(_queue)) {
+            _local(QueueingDeliveryPolicy(_queue)),
+            _telemetry_enabled(false),
+            _telemetry_batch(0) {
+            bind_post();
         }
 
         Module(std::tr1::shared_ptr<EventRouter> central) :
             _central(central), 
             _queue(new EventQueue), 
-            _local(QueueingDeliveryPolicy(_queue)) {
+            _local(QueueingDeliveryPolicy(_queue)),
+            _telemetry_enabled(false),
+            _telemetry_batch(0) {
+            bind_post();
+        }
+
+        /**
+         * @brief Queue a task to run when the module processes its events, on
+         * whichever thread runs the module.  May be called from any thread.
+         */
+        void post(const Task& task) {
+            _queue->enqueue_value(_local, _post_topic, task);
+        }
+
+
+        /**
+         * @brief Set how events are queued for bindings made without a
+         * @c QueueMode.  Use @c Conflate so that a module which falls behind
+         * only processes the latest value of each binding.
+         */
+        void set_queue_mode(QueueMode mode) { _queue->set_default_mode(mode); }
+
+        /**
+         * @brief Bound the module's queue so that its memory stays fixed when
+         * events arrive faster than the module processes them.
+         * @param capacity maximum number of queued events
+         * @param policy what to do with events arriving while the queue is full
+         * @see EventQueue
+         */
+        void set_queue_capacity(std::size_t capacity, OverflowPolicy policy) {
+            _queue->set_capacity(capacity, policy);
+        }
+
+        /** @brief Counters for the module's queue, including dropped and blocked events. */
+        QueueStats queue_stats() const { return _queue->stats(); }
+
+        /** @brief Add a listener told when the module's queue becomes non-empty. */
+        void add_ready_listener(ReadyListener* listener) { _queue->add_ready_listener(listener); }
+
+        void remove_ready_listener(ReadyListener* listener) { _queue->remove_ready_listener(listener); }
+
+        /**
+         * @brief Count the events the module processes, the wall and CPU time
+         * its handlers take and how long events wait in its queue.  Handler
+         * times are sampled, as described for @c ModuleTelemetry.
+         */
+        void enable_telemetry(bool enabled = true) {
+            _telemetry_enabled = enabled;
+            _telemetry_batch = 0;
+            _queue->set_latency_histogram(enabled ? &_telemetry.latency() : 0);
+        }
+
+        bool is_telemetry_enabled() const { return _telemetry_enabled; }
+
+        /** @brief Snapshot of the module's telemetry; may be read from any thread. */
+        ModuleStats telemetry() const {
+            ModuleStats stats = _telemetry.snapshot();
+            stats.high_water_mark = _queue->high_water_mark();
+            return stats;
         }
 
+        /** @brief Queue latency of the events delivered from one priority lane. */
+        LaneStats lane_stats(EventPriority priority) const { return _queue->lane_stats(priority); }
 
         template <typename T>
         void bind_value(const std::string& name, T* value) {
-            _local.subscribe<T>(name).assign_to(value);
-            _central->route(name, _local);
+            bind_topic<T>(name, ASSIGN_TO<T, T*>(value));
+        }
+
+        /**
+         * @brief Bind a history of a timestamped value, appending each value
+         * published on @c name.
+         */
+        template <typename T, std::size_t N>
+        void bind_value(const std::string& name, TimestampedHistory<T, N>* history) {
+            bind_topic< Timestamped<T> >(name, PUSH_TO_HISTORY<T, N>(history));
+        }
+
+        /** @brief Bind a value, queueing its events according to @c mode. */
+        template <typename T>
+        void bind_value(const std::string& name, T* value, QueueMode mode) {
+            _queue->set_mode(_local.topic(name), mode);
+            bind_value(name, value);
+        }
+
+        /** @brief Bind a value, queueing its events in the lane for @c priority. */
+        template <typename T>
+        void bind_value(const std::string& name, T* value, EventPriority priority) {
+            _queue->set_priority(_local.topic(name), priority);
+            bind_value(name, value);
+        }
+
+        /** @brief Bind a value with both a queue mode and a priority. */
+        template <typename T>
+        void bind_value(const std::string& name, T* value,
+                        QueueMode mode, EventPriority priority) {
+            _queue->set_priority(_local.topic(name), priority);
+            bind_value(name, value, mode);
+        }
+
+        /**
+         * @brief Create a join calling @c callback once per complete set of
+         * new values of the inputs bound to it.
+         * @param tolerance largest spread of the inputs' timestamps
+         * @see Join
+         */
+        Join& join(Join::Callback callback, Timestampable::Clock::duration tolerance) {
+            _joins.push_back(std::tr1::shared_ptr<Join>(new Join(callback, tolerance)));
+            return *_joins.back();
+        }
+
+        /** @brief Bind a timestamped value as a member of @c join. */
+        template <typename T>
+        void bind_value(const std::string& name, T* value, Join& join) {
+            bind_topic<T>(name, JOIN_VALUE<T>(value, join, join.add(*value)));
         }
 
         template <typename T>
         void bind_fn(const std::string& name,
                      std::tr1::function<void(T)> fn) {
-            _local.subscribe<T>(name).deliver_with2(fn);
-            _central->route(name, _local);
+            typedef typename boost::remove_const<typename boost::remove_reference<T>::type>::type Value;
+            bind_topic<Value>(name, fn);
+        }
+
+        /** @brief Bind a function, queueing its events according to @c mode. */
+        template <typename T>
+        void bind_fn(const std::string& name,
+                     std::tr1::function<void(T)> fn,
+                     QueueMode mode) {
+            _queue->set_mode(_local.topic(name), mode);
+            bind_fn(name, fn);
+        }
+
+        /** @brief Bind a function, queueing its events in the lane for @c priority. */
+        template <typename T>
+        void bind_fn(const std::string& name,
+                     std::tr1::function<void(T)> fn,
+                     EventPriority priority) {
+            _queue->set_priority(_local.topic(name), priority);
+            bind_fn(name, fn);
+        }
+
+        /** @brief Bind a function with both a queue mode and a priority. */
+        template <typename T>
+        void bind_fn(const std::string& name,
+                     std::tr1::function<void(T)> fn,
+                     QueueMode mode,
+                     EventPriority priority) {
+            _queue->set_priority(_local.topic(name), priority);
+            bind_fn(name, fn, mode);
         }
 
         virtual int process(int n=1) {
             int nr_to_process = std::min(n, _queue->size());
-            for (int i=0; i < nr_to_process; i++) {
-                _queue->deliver();
+            if (!_telemetry_enabled || nr_to_process == 0) {
+                deliver(nr_to_process);
+            } else if (_telemetry_batch++ % TELEMETRY_TIMED_BATCHES != 0) {
+                deliver(nr_to_process);
+                _telemetry.record(nr_to_process);
+            } else {
+                // Handler time is real time, even when the clock is simulated
+                boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+                boost::chrono::nanoseconds cpu_start = thread_cpu_time();
+                deliver(nr_to_process);
+                _telemetry.record(nr_to_process,
+                                  boost::chrono::steady_clock::now() - start,
+                                  thread_cpu_time() - cpu_start);
             }
             return nr_to_process;
         }
@@ -50,14 +210,74 @@ namespace j2 {
             return process(_queue->size());
         }
         
+        /**
+         * @brief Periodic work of the module, run once per cycle by a
+         * @c DeadlineScheduler after the module's queued events.
+         */
+        virtual void update() { }
+
         virtual bool is_ready() { return !_queue->empty(); }
 
         virtual bool is_idle() { return _queue->empty(); }
 
+    private:
+        static void run_task(const Task& task) { task(); }
+
+        void bind_post() {
+            _post_topic = _local.topic(MODULE_POST_TOPIC);
+            _local.channel<Task>(_post_topic).deliver_with(&Module::run_task);
+        }
+
+        void deliver(int n) {
+            for (int i=0; i < n; i++) {
+                _queue->deliver();
+            }
+        }
+
+        // Deliver the values published on a topic of the central router to
+        // a delegate taking a const T& when this module processes them
+        template <typename T, typename F>
+        void bind_topic(const std::string& name, const F& delegate) {
+            TopicId topic = _local.topic(name);
+            boost::optional< Channel<T> > channel = _local.try_channel<T>(topic);
+            if (channel) {
+                channel->deliver_with(delegate);
+            } else {
+                _local.subscribe<T>(topic).deliver_with2(delegate);
+            }
+            route<T>(name, topic);
+        }
+
+        // Forward typed events from the central router straight into our
+        // queue, so that routing a value into the module does not allocate.
+        // A topic's channels carry a single type, so when another binding
+        // already uses a different type, such as float rather than double,
+        // the events are routed boxed instead, as for an untyped subscription.
+        // Either way a value of the wrong type published untyped fails to
+        // cast when this module processes it, not in the publisher.
+        template <typename T>
+        void route(const std::string& name, TopicId topic) {
+            TopicId source = _central->topic(name);
+            boost::optional< Channel<T> > channel = _central->try_channel<T>(source);
+            if (!channel) {
+                _central->route(source, _local, topic);
+                return;
+            }
+            channel->deliver_with(QUEUE_VALUE<T>(_queue, _local, topic));
+            channel->deliver_mismatched_with(QUEUE_ANY(_queue, _local, topic));
+        }
+
     protected:
         std::tr1::shared_ptr<EventRouter> _central;
         std::tr1::shared_ptr<EventQueue> _queue;
         EventRouter _local;
+
+    private:
+        ModuleTelemetry _telemetry;
+        bool _telemetry_enabled;
+        unsigned _telemetry_batch;
+        TopicId _post_topic;
+        std::vector<std::tr1::shared_ptr<Join> > _joins;
     };
 
 } // namespace j2
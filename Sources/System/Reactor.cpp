@@ -0,0 +1,132 @@
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <boost/chrono/ceil.hpp>
+#include "Reactor.h"
+
+using namespace j2;
+
+namespace {
+    const int MAX_REACTOR_EVENTS = 32;
+
+    // Wake latency is real time, even when the clock is simulated
+    typedef boost::chrono::steady_clock WakeClock;
+
+    void throw_errno(const char* what) {
+        throw std::runtime_error(std::string(what) + ": " + strerror(errno));
+    }
+
+    // Round up, so that a wait never returns just before its timeout
+    int timeout_ms(const boost::optional<EventClock::duration>& timeout) {
+        if (!timeout) return -1;
+        if (*timeout <= EventClock::duration::zero()) return 0;
+        return int(boost::chrono::ceil<boost::chrono::milliseconds>(*timeout).count());
+    }
+}
+
+Reactor::Reactor() :
+    _epoll(epoll_create1(EPOLL_CLOEXEC)),
+    _wake_fd(-1),
+    _woken(false),
+    _woken_at(0) {
+    if (_epoll < 0) throw_errno("epoll_create1");
+    _wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wake_fd < 0) {
+        close(_epoll);
+        throw_errno("eventfd");
+    }
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = _wake_fd;
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake_fd, &event) < 0) {
+        close(_wake_fd);
+        close(_epoll);
+        throw_errno("epoll_ctl");
+    }
+}
+
+Reactor::~Reactor() {
+    close(_wake_fd);
+    close(_epoll);
+}
+
+void Reactor::watch(int fd, Handler handler, int events) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    if (events & Readable) event.events |= EPOLLIN;
+    if (events & Writable) event.events |= EPOLLOUT;
+    event.data.fd = fd;
+    int op = _handlers.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(_epoll, op, fd, &event) < 0) throw_errno("epoll_ctl");
+    _handlers[fd].reset(new Handler(handler));
+}
+
+void Reactor::unwatch(int fd) {
+    if (!_handlers.erase(fd)) return;
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, 0);
+}
+
+void Reactor::wake() {
+    if (_woken.exchange(true)) return;
+    _woken_at.store(WakeClock::now().time_since_epoch().count(), boost::memory_order_relaxed);
+    uint64_t one = 1;
+    ssize_t written = write(_wake_fd, &one, sizeof(one));
+    (void)written;
+}
+
+std::size_t Reactor::wait(boost::optional<EventClock::duration> timeout) {
+    struct epoll_event events[MAX_REACTOR_EVENTS];
+    WakeClock::time_point parked = WakeClock::now();
+    int count = epoll_wait(_epoll, events, MAX_REACTOR_EVENTS, timeout_ms(timeout));
+    if (count < 0) {
+        if (errno == EINTR) return 0;
+        throw_errno("epoll_wait");
+    }
+    WakeClock::time_point resumed = WakeClock::now();
+
+    std::size_t handled = 0;
+    for (int i = 0; i < count; i++) {
+        int fd = events[i].data.fd;
+        if (fd == _wake_fd) {
+            WakeClock::time_point woken(WakeClock::duration(_woken_at.load(boost::memory_order_relaxed)));
+            // Drain the eventfd before clearing the flag.  The other way
+            // round, a wake in between would have its write drained while
+            // the flag stayed set, so no later wake would write again.  This
+            // way such a wake is merely absorbed by the thread already awake.
+            uint64_t value;
+            ssize_t got = read(_wake_fd, &value, sizeof(value));
+            (void)got;
+            _woken.store(false);
+            // Only count wakes that found the thread parked, rather than ones
+            // left over from while it was busy
+            if (woken >= parked) {
+                boost::mutex::scoped_lock lock(_stats_mutex);
+                EventClock::duration latency = resumed - woken;
+                _stats.wakeups++;
+                _stats.total_latency += latency;
+                if (latency > _stats.max_latency) _stats.max_latency = latency;
+            }
+            continue;
+        }
+        std::map<int, std::tr1::shared_ptr<Handler> >::iterator it = _handlers.find(fd);
+        if (it == _handlers.end()) continue;
+        // Hold on to the handler, since it may unwatch its descriptor.
+        // Sharing it rather than copying keeps a bound handler from
+        // allocating on every event.
+        std::tr1::shared_ptr<Handler> handler = it->second;
+        (*handler)();
+        handled++;
+    }
+    return handled;
+}
+
+WakeStats Reactor::wake_stats() const {
+    boost::mutex::scoped_lock lock(_stats_mutex);
+    return _stats;
+}
@@ -0,0 +1,96 @@
+#ifndef _REACTOR_H
+#define _REACTOR_H
+
+#include <map>
+#include <cstddef>
+#include <tr1/memory>
+#include <tr1/functional>
+#include <boost/atomic.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+#include <EventRouter.h>
+
+namespace j2 {
+
+    /** @brief Time taken for a parked @c Reactor to resume after @c wake. */
+    struct WakeStats {
+        WakeStats() : wakeups(0), total_latency(0), max_latency(0) { }
+
+        EventClock::duration mean_latency() const {
+            if (wakeups == 0) return EventClock::duration(0);
+            return total_latency / EventClock::rep(wakeups);
+        }
+
+        std::size_t wakeups;                    ///< Times woken while parked
+        EventClock::duration total_latency;     ///< Sum of time from wake to resuming
+        EventClock::duration max_latency;       ///< Longest time from wake to resuming
+    };
+
+    /**
+     * @brief Parks a thread until a descriptor is ready, a timeout
+     * expires or another thread calls @c wake.
+     *
+     * Built on epoll with an eventfd for @c wake, which only writes to the
+     * eventfd once per park however many times it is called, so waking a
+     * reactor that is busy costs a single atomic exchange.
+     *
+     * Descriptors are watched and handlers run on the thread calling
+     * @c wait; only @c wake may be called from other threads.
+     */
+    class Reactor {
+    public:
+        typedef std::tr1::function<void ()> Handler;
+
+        /** @brief What a descriptor is watched for, combined with '|'. */
+        enum Events {
+            Readable = 1,
+            Writable = 2
+        };
+
+        /** @throws std::runtime_error if epoll or the eventfd cannot be created */
+        Reactor();
+
+        ~Reactor();
+
+        /**
+         * @brief Run @c handler from @c wait whenever @c fd is ready for any
+         * of @c events, or has failed.  Watching a descriptor again replaces
+         * its handler and events.
+         */
+        void watch(int fd, Handler handler, int events = Readable);
+
+        void unwatch(int fd);
+
+        /** @brief Make the current or next @c wait return. */
+        void wake();
+
+        /**
+         * @brief Wait for ready descriptors or a wake, running the handlers
+         * of the descriptors.
+         * @param timeout longest time to wait; forever if empty
+         * @return number of handlers run
+         */
+        std::size_t wait(boost::optional<EventClock::duration> timeout);
+
+        /** @brief Run the handlers of descriptors that are already ready. */
+        std::size_t poll() { return wait(EventClock::duration::zero()); }
+
+        WakeStats wake_stats() const;
+
+    private:
+        // Not copyable
+        Reactor(const Reactor&);
+        Reactor& operator=(const Reactor&);
+
+        int _epoll;
+        int _wake_fd;
+        std::map<int, std::tr1::shared_ptr<Handler> > _handlers;
+        boost::atomic<bool> _woken;
+        boost::atomic<EventClock::rep> _woken_at;
+        WakeStats _stats;
+        mutable boost::mutex _stats_mutex;
+    };
+
+} // namespace j2
+
+#endif // _REACTOR_H
@@ -2,10 +2,18 @@
 #define _SUPERVISOR_H
 
 #include <vector>
+#include <algorithm>
 #include <tr1/memory>
 #include <boost/mem_fn.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
 #include <Module.h>
 #include <EventRouter.h>
+#include <WorkerPool.h>
+#include <Reactor.h>
+#include <TimerWheel.h>
 
 
 namespace j2 {
@@ -27,7 +35,23 @@ namespace j2 {
          * @param modules List of modules to schedule
          * @return Module that was scheduled or empty if none was ready
          */
-        virtual boost::optional<Module*> schedule(ModuleList modules) = 0;
+        virtual boost::optional<Module*> schedule(const ModuleList& modules) = 0;
+
+        /**
+         * @brief Called when a module is loaded.  Schedulers that track
+         * readiness themselves override this to listen to the module's queue.
+         */
+        virtual void attach(const SharedModule&) { }
+
+        /**
+         * @brief When the scheduler next has work that is not triggered by an
+         * event, such as a periodic module; empty if never.
+         */
+        virtual boost::optional<EventClock::time_point> next_release() const {
+            return boost::optional<EventClock::time_point>();
+        }
+
+        virtual ~Scheduler() { }
     };
 
     
@@ -35,8 +59,8 @@ namespace j2 {
     public:
         static Scheduler* instance();
     public:
-        virtual boost::optional<Module*> schedule(ModuleList modules) {
-            ModuleList::iterator it = std::find_if(modules.begin(), modules.end(),
+        virtual boost::optional<Module*> schedule(const ModuleList& modules) {
+            ModuleList::const_iterator it = std::find_if(modules.begin(), modules.end(),
                                                    boost::mem_fn(&j2::Module::is_ready));
             if (it != modules.end()) {
                 (*it)->process_one();
@@ -54,28 +78,326 @@ namespace j2 {
         return instance_;
     }
 
+    /**
+     * @class Scheduler running ready modules round-robin from a ready list.
+     *
+     * Modules are appended to the ready list when their queue goes from empty
+     * to non-empty, so picking the next module costs the same however many
+     * modules are loaded.  A module that still has events after being
+     * scheduled goes to the back of the list, so a busy module cannot starve
+     * the others.  Unlike @c BasicScheduler each Supervisor needs its own
+     * instance.
+     */
+    class ReadySetScheduler : public Scheduler {
+    public:
+        ReadySetScheduler() : _head(0), _tail(0) { }
+
+        virtual ~ReadySetScheduler() {
+            for (Entries::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+                (*it)->module->remove_ready_listener(it->get());
+            }
+        }
+
+        virtual void attach(const SharedModule& module) {
+            Entry* entry = 0;
+            for (Entries::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+                if ((*it)->module == module) entry = it->get();
+            }
+            if (!entry) {
+                _entries.push_back(std::tr1::shared_ptr<Entry>(new Entry(*this, module)));
+                entry = _entries.back().get();
+            }
+            module->add_ready_listener(entry);
+            if (module->is_ready()) push(entry);
+        }
+
+        /** @brief Process one event of the module at the front of the ready list. */
+        virtual boost::optional<Module*> schedule(const ModuleList&) {
+            Entry* entry;
+            while ((entry = pop())) {
+                // The module may have been drained since it was listed
+                if (!entry->module->is_ready()) continue;
+                entry->module->process_one();
+                if (entry->module->is_ready()) push(entry);
+                return boost::optional<Module*>(entry->module.get());
+            }
+            return boost::optional<Module*>();
+        }
+
+    private:
+        // Node of the ready list, kept alongside its module
+        struct Entry : public ReadyListener {
+            Entry(ReadySetScheduler& scheduler, const SharedModule& module) :
+                scheduler(scheduler), module(module), next(0), listed(false) { }
+
+            virtual void ready(EventQueue&) { scheduler.push(this); }
+
+            ReadySetScheduler& scheduler;
+            SharedModule module;
+            Entry* next;
+            bool listed;
+        };
+
+        typedef std::vector<std::tr1::shared_ptr<Entry> > Entries;
+
+        void push(Entry* entry) {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (entry->listed) return;
+            entry->listed = true;
+            entry->next = 0;
+            if (_tail) _tail->next = entry;
+            else _head = entry;
+            _tail = entry;
+        }
+
+        Entry* pop() {
+            boost::mutex::scoped_lock lock(_mutex);
+            Entry* entry = _head;
+            if (!entry) return 0;
+            _head = entry->next;
+            if (!_head) _tail = 0;
+            entry->listed = false;
+            return entry;
+        }
+
+        Entries _entries;
+        Entry* _head;
+        Entry* _tail;
+        boost::mutex _mutex;
+    };
+
     class Supervisor {
     public:
         Supervisor(Scheduler *scheduler = BasicScheduler::instance(),
                    EventRouter* router = EventRouter::instance()) :
             scheduler(scheduler),
-            router(router) { }
+            router(router),
+            waker(reactor),
+            interrupted(false),
+            telemetry(false) {
+            timer_wheel.set_wake(boost::bind(&Reactor::wake, &reactor));
+        }
+
+        ~Supervisor() {
+            stop();
+            for (ModuleList::const_iterator it = modules.begin(); it != modules.end(); ++it) {
+                (*it)->remove_ready_listener(&waker);
+            }
+        }
 
         template <class T>
         boost::shared_ptr<T> load() {
             SharedModule module(new T(router));
+            if (telemetry) module->enable_telemetry();
             modules.push_back(module);
+            if (pool) pool->add(module);
+            scheduler->attach(module);
+            module->add_ready_listener(&waker);
             return boost::dynamic_pointer_cast<T>(module);
         }
 
+        /**
+         * @brief Run one ready module chosen by the scheduler.  Does nothing
+         * while workers started by @c start run the modules, so that no
+         * module is processed on two threads at once; @c run and @c poll
+         * then only serve timers and descriptors.
+         * @return Module that was scheduled or empty if none was
+         */
         boost::optional<Module*> schedule() {
+            if (is_running()) return boost::optional<Module*>();
             return scheduler->schedule(modules);
         }
 
-    private:    
+        /**
+         * @brief Run the loaded modules on a pool of worker threads instead
+         * of through @c schedule.  Each module still runs on one thread at a
+         * time, as soon as it has events.
+         * @param threads number of worker threads
+         * @see WorkerPool
+         */
+        void start(std::size_t threads = boost::thread::hardware_concurrency()) {
+            if (!pool) {
+                pool.reset(new WorkerPool);
+                for (ModuleList::const_iterator it = modules.begin(); it != modules.end(); ++it) {
+                    pool->add(*it);
+                }
+            }
+            pool->start(threads);
+        }
+
+        /** @brief Stop and join the worker threads started by @c start. */
+        void stop() {
+            if (pool) pool->stop();
+        }
+
+        bool is_running() const { return pool && pool->is_running(); }
+
+        /**
+         * @brief Schedule modules on this thread until @c interrupt is called,
+         * parking whenever there is nothing to do.
+         *
+         * The thread wakes when an event is queued for a module, when a timer
+         * or the scheduler's next release comes due, or when a descriptor
+         * given to @c watch becomes readable.
+         */
+        void run() {
+            interrupted.store(false);
+            while (!interrupted.load()) run_once(boost::optional<EventClock::time_point>());
+        }
+
+        /**
+         * @brief Run as @c run for at most @c duration.
+         * @return number of modules scheduled
+         */
+        std::size_t run_for(EventClock::duration duration) {
+            EventClock::time_point deadline = EventClock::now() + duration;
+            std::size_t scheduled = 0;
+            interrupted.store(false);
+            while (!interrupted.load() && EventClock::now() < deadline) {
+                scheduled += run_once(deadline);
+            }
+            return scheduled;
+        }
+
+        /**
+         * @brief Do the work due now without waiting: fire due timers, run the
+         * handlers of readable descriptors and schedule modules until none is
+         * ready.
+         * @return number of modules scheduled
+         */
+        std::size_t poll() {
+            std::size_t scheduled = 0;
+            timer_wheel.advance();
+            reactor.poll();
+            while (schedule()) scheduled++;
+            return scheduled;
+        }
+
+        /**
+         * @brief Move a simulated clock forward to @c until, stopping at each
+         * timer expiry and scheduler release on the way, so that every
+         * module sees the same times as in a real time run.
+         * @return number of modules scheduled
+         */
+        std::size_t run_until(SimulatedClock& clock, EventClock::time_point until) {
+            std::size_t scheduled = poll();
+            for (;;) {
+                boost::optional<EventClock::time_point> next = timer_wheel.next_expiry();
+                boost::optional<EventClock::time_point> release = scheduler->next_release();
+                if (release && (!next || *release < *next)) next = release;
+                if (!next || *next > until) break;
+                clock.set(*next);
+                scheduled += poll();
+            }
+            clock.set(until);
+            return scheduled + poll();
+        }
+
+        /** @brief Make @c run or @c run_for return; may be called from any thread. */
+        void interrupt() {
+            interrupted.store(true);
+            reactor.wake();
+        }
+
+        /**
+         * @brief Call @c handler from @c run whenever @c fd is ready for any
+         * of @c events, as for @c Reactor::watch.
+         * Call from the thread running the supervisor, or before it runs.
+         */
+        void watch(int fd, Reactor::Handler handler, int events = Reactor::Readable) {
+            reactor.watch(fd, handler, events);
+        }
+
+        void unwatch(int fd) { reactor.unwatch(fd); }
+
+        /** @brief Enable telemetry on every module, including ones loaded later. */
+        void enable_telemetry(bool enabled = true) {
+            telemetry = enabled;
+            for (ModuleList::const_iterator it = modules.begin(); it != modules.end(); ++it) {
+                (*it)->enable_telemetry(enabled);
+            }
+        }
+
+        /**
+         * @brief Telemetry of each module, in the order they were loaded.
+         * May be called from any thread while modules run.
+         */
+        std::vector<ModuleStats> module_stats() const {
+            std::vector<ModuleStats> stats;
+            stats.reserve(modules.size());
+            for (ModuleList::const_iterator it = modules.begin(); it != modules.end(); ++it) {
+                stats.push_back((*it)->telemetry());
+            }
+            return stats;
+        }
+
+        /**
+         * @brief Timers fired by @c run and @c run_for.  Use @c PUBLISH_TIMER
+         * to have a timer publish on a topic, or @c POST_TIMER to have it run
+         * a task on a module.
+         */
+        TimerWheel& timers() { return timer_wheel; }
+
+        /** @brief Time taken by @c run to resume after parking. */
+        WakeStats wake_stats() const { return reactor.wake_stats(); }
+
+        /**
+         * @brief Queue counters summed over all loaded modules.  The high
+         * water mark is the largest of any module.
+         */
+        QueueStats queue_stats() const {
+            QueueStats total;
+            for (ModuleList::const_iterator it = modules.begin(); it != modules.end(); ++it) {
+                QueueStats stats = (*it)->queue_stats();
+                total.size += stats.size;
+                total.high_water_mark = std::max(total.high_water_mark, stats.high_water_mark);
+                total.dropped += stats.dropped;
+                total.blocked += stats.blocked;
+                total.spilled += stats.spilled;
+            }
+            return total;
+        }
+
+    private:
+        // Wakes the run loop when a module's queue becomes non-empty
+        class Waker : public ReadyListener {
+        public:
+            explicit Waker(Reactor& reactor) : _reactor(reactor) { }
+            virtual void ready(EventQueue&) { _reactor.wake(); }
+        private:
+            Reactor& _reactor;
+        };
+
+        // Number of modules scheduled between checks of the descriptors
+        static const std::size_t RUN_BATCH = 64;
+
+        std::size_t run_once(boost::optional<EventClock::time_point> deadline) {
+            std::size_t scheduled = 0;
+            timer_wheel.advance();
+            while (scheduled < RUN_BATCH && !interrupted.load() && schedule()) scheduled++;
+            if (scheduled > 0) {
+                reactor.poll();
+                return scheduled;
+            }
+            boost::optional<EventClock::time_point> release = scheduler->next_release();
+            if (release && (!deadline || *release < *deadline)) deadline = release;
+            boost::optional<EventClock::time_point> expiry = timer_wheel.next_expiry();
+            if (expiry && (!deadline || *expiry < *deadline)) deadline = expiry;
+            boost::optional<EventClock::duration> timeout;
+            if (deadline) timeout = *deadline - EventClock::now();
+            reactor.wait(timeout);
+            return 0;
+        }
+
         ModuleList modules;
         std::tr1::shared_ptr<EventRouter> router;
         Scheduler* scheduler;
+        boost::scoped_ptr<WorkerPool> pool;
+        Reactor reactor;
+        TimerWheel timer_wheel;
+        Waker waker;
+        boost::atomic<bool> interrupted;
+        bool telemetry;
     };
 
 } // namespace j2
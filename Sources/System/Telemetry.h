@@ -0,0 +1,200 @@
+#ifndef _TELEMETRY_H
+#define _TELEMETRY_H
+
+#include <cstddef>
+#include <time.h>
+#include <stdint.h>
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+
+namespace j2 {
+
+    /** @brief One in this many batches of events a module processes is timed. */
+    const unsigned TELEMETRY_TIMED_BATCHES = 64;
+
+    /**
+     * @brief Add to a counter that only one thread at a time writes.  Readers
+     * may see a stale value but never a torn one, without the cost of a
+     * locked read-modify-write.
+     */
+    template <typename T, typename U>
+    inline void add_counter(boost::atomic<T>& counter, U amount) {
+        counter.store(counter.load(boost::memory_order_relaxed) + T(amount), boost::memory_order_relaxed);
+    }
+
+    /** @brief Number of buckets in a @c LatencyHistogram. */
+    const std::size_t LATENCY_BUCKETS = 40;
+
+    /** @brief Copy of the counts of a @c LatencyHistogram. */
+    struct LatencySnapshot {
+        LatencySnapshot() : count(0) {
+            for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) buckets[i] = 0;
+        }
+
+        /** @brief Upper bound of the latencies counted in a bucket. */
+        static boost::chrono::nanoseconds bucket_limit(std::size_t bucket) {
+            return boost::chrono::nanoseconds(int64_t(1) << bucket);
+        }
+
+        /**
+         * @brief Latency below which a fraction of the samples fall, rounded
+         * up to a bucket limit.
+         * @param fraction between 0 and 1, such as 0.99
+         */
+        boost::chrono::nanoseconds percentile(double fraction) const {
+            if (count == 0) return boost::chrono::nanoseconds(0);
+            uint64_t wanted = uint64_t(fraction * double(count) + 0.5);
+            if (wanted == 0) wanted = 1;
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) {
+                seen += buckets[i];
+                if (seen >= wanted) return bucket_limit(i);
+            }
+            return bucket_limit(LATENCY_BUCKETS - 1);
+        }
+
+        uint64_t count;                         ///< Samples recorded
+        uint64_t buckets[LATENCY_BUCKETS];      ///< Samples below each power of two nanoseconds
+    };
+
+    /**
+     * @brief Histogram of latencies in power of two buckets.
+     *
+     * Recording is a relaxed atomic load and store, so one thread at a time
+     * can record while others take snapshots without a lock.  Bucket @c i counts latencies
+     * from 2^(i-1) up to 2^i nanoseconds; the last bucket also counts
+     * anything longer.
+     */
+    class LatencyHistogram {
+    public:
+        LatencyHistogram() { reset(); }
+
+        template <typename Rep, typename Period>
+        void record(boost::chrono::duration<Rep, Period> latency) {
+            int64_t ns = boost::chrono::duration_cast<boost::chrono::nanoseconds>(latency).count();
+            add_counter(_buckets[bucket(ns)], 1);
+        }
+
+        LatencySnapshot snapshot() const {
+            LatencySnapshot snapshot;
+            for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) {
+                snapshot.buckets[i] = _buckets[i].load(boost::memory_order_relaxed);
+                snapshot.count += snapshot.buckets[i];
+            }
+            return snapshot;
+        }
+
+        void reset() {
+            for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) {
+                _buckets[i].store(0, boost::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static std::size_t bucket(int64_t ns) {
+            if (ns <= 1) return 0;
+            std::size_t b = 64 - __builtin_clzll(uint64_t(ns - 1));
+            return b < LATENCY_BUCKETS ? b : LATENCY_BUCKETS - 1;
+        }
+
+        // Not copyable
+        LatencyHistogram(const LatencyHistogram&);
+        LatencyHistogram& operator=(const LatencyHistogram&);
+
+        boost::atomic<uint64_t> _buckets[LATENCY_BUCKETS];
+    };
+
+    /** @brief CPU time used by the calling thread. */
+    inline boost::chrono::nanoseconds thread_cpu_time() {
+        struct timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return boost::chrono::nanoseconds(int64_t(now.tv_sec) * 1000000000 + now.tv_nsec);
+    }
+
+    /** @brief Copy of the counters of a @c ModuleTelemetry. */
+    struct ModuleStats {
+        ModuleStats() : events(0), batches(0), timed_events(0), wall_time(0), cpu_time(0), high_water_mark(0) { }
+
+        /** @brief Mean time handlers took per event, over the timed batches. */
+        boost::chrono::nanoseconds mean_wall_time() const {
+            if (timed_events == 0) return boost::chrono::nanoseconds(0);
+            return wall_time / int64_t(timed_events);
+        }
+
+        /** @brief Mean thread CPU time handlers took per event, over the timed batches. */
+        boost::chrono::nanoseconds mean_cpu_time() const {
+            if (timed_events == 0) return boost::chrono::nanoseconds(0);
+            return cpu_time / int64_t(timed_events);
+        }
+
+        uint64_t events;                        ///< Events delivered to handlers
+        uint64_t batches;                       ///< Calls to process that delivered events
+        uint64_t timed_events;                  ///< Events delivered in the batches timed
+        boost::chrono::nanoseconds wall_time;   ///< Time spent in handlers in the batches timed
+        boost::chrono::nanoseconds cpu_time;    ///< Thread CPU time spent in handlers in the batches timed
+        std::size_t high_water_mark;            ///< Deepest the module's queue has been
+        LatencySnapshot latency;                ///< Time events spent queued
+    };
+
+    /**
+     * @brief Counters of the work a module does, readable from any thread.
+     *
+     * Every batch of events is counted, but reading the clocks costs far
+     * more than delivering an event, the thread CPU time being a system
+     * call, so only one batch in @c TELEMETRY_TIMED_BATCHES is timed.
+     * Handler times are therefore totals over a sample of the events,
+     * best read as means per event.  Only the thread processing the module
+     * records, so counting a batch is a few relaxed loads and stores.
+     */
+    class ModuleTelemetry {
+    public:
+        ModuleTelemetry() : _events(0), _batches(0), _timed_events(0), _wall_time(0), _cpu_time(0) { }
+
+        /** @brief Count a batch of events. */
+        void record(std::size_t events) {
+            if (events == 0) return;
+            add_counter(_events, events);
+            add_counter(_batches, 1);
+        }
+
+        /** @brief Count a batch of events and the time spent delivering them. */
+        void record(std::size_t events,
+                    boost::chrono::nanoseconds wall_time,
+                    boost::chrono::nanoseconds cpu_time) {
+            if (events == 0) return;
+            record(events);
+            add_counter(_timed_events, events);
+            add_counter(_wall_time, wall_time.count());
+            add_counter(_cpu_time, cpu_time.count());
+        }
+
+        /** @brief Histogram of time events spent queued; recorded by the queue. */
+        LatencyHistogram& latency() { return _latency; }
+
+        ModuleStats snapshot() const {
+            ModuleStats stats;
+            stats.events = _events.load(boost::memory_order_relaxed);
+            stats.batches = _batches.load(boost::memory_order_relaxed);
+            stats.timed_events = _timed_events.load(boost::memory_order_relaxed);
+            stats.wall_time = boost::chrono::nanoseconds(_wall_time.load(boost::memory_order_relaxed));
+            stats.cpu_time = boost::chrono::nanoseconds(_cpu_time.load(boost::memory_order_relaxed));
+            stats.latency = _latency.snapshot();
+            return stats;
+        }
+
+    private:
+        // Not copyable
+        ModuleTelemetry(const ModuleTelemetry&);
+        ModuleTelemetry& operator=(const ModuleTelemetry&);
+
+        boost::atomic<uint64_t> _events;
+        boost::atomic<uint64_t> _batches;
+        boost::atomic<uint64_t> _timed_events;
+        boost::atomic<int64_t> _wall_time;
+        boost::atomic<int64_t> _cpu_time;
+        LatencyHistogram _latency;
+    };
+
+} // namespace j2
+
+#endif // _TELEMETRY_H
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include "TimerWheel.h"
+
+using namespace j2;
+
+const std::size_t TimerWheel::TIMER_LEVELS;
+const std::size_t TimerWheel::TIMER_SLOTS;
+const uint32_t TimerWheel::NIL;
+const std::size_t TimerWheel::DUE_SLOT;
+const std::size_t TimerWheel::SLOT_WORDS;
+
+namespace {
+    const std::size_t SLOT_BITS = 8;
+
+    std::size_t level_index(uint64_t tick, std::size_t level) {
+        return std::size_t(tick >> (SLOT_BITS * level)) & (TimerWheel::TIMER_SLOTS - 1);
+    }
+}
+
+TimerWheel::TimerWheel(EventClock::duration tick, EventClock::time_point start) :
+    _tick(tick),
+    _start(start),
+    _now(0),
+    _size(0) {
+    std::fill(_heads, _heads + DUE_SLOT + 1, NIL);
+    for (std::size_t level = 0; level < TIMER_LEVELS; level++) {
+        std::fill(_occupied[level], _occupied[level] + SLOT_WORDS, uint64_t(0));
+    }
+}
+
+TimerId TimerWheel::schedule(EventClock::time_point when, Handler handler,
+                             EventClock::duration period) {
+    std::tr1::function<void ()> wake;
+    TimerId id;
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        uint32_t index;
+        if (_free.empty()) {
+            index = uint32_t(_timers.size());
+            _timers.push_back(Timer());
+        } else {
+            index = _free.back();
+            _free.pop_back();
+        }
+        Timer& timer = _timers[index];
+        timer.expiry = to_tick(when);
+        timer.period = 0;
+        if (period > EventClock::duration::zero()) {
+            timer.period = std::max<uint64_t>(1, (period + _tick - EventClock::duration(1)) / _tick);
+        }
+        timer.handler = handler;
+        insert(index);
+        _size++;
+        id = (TimerId(timer.generation) << 32) | index;
+        wake = _wake;
+    }
+    if (wake) wake();
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    boost::mutex::scoped_lock lock(_mutex);
+    uint32_t index = uint32_t(id);
+    if (index >= _timers.size()) return false;
+    Timer& timer = _timers[index];
+    // Released timers have moved on to the next generation
+    if (timer.generation != uint32_t(id >> 32)) return false;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+std::size_t TimerWheel::advance(EventClock::time_point now) {
+    std::size_t fired = 0;
+    boost::mutex::scoped_lock lock(_mutex);
+    uint64_t target = now < _start ? 0 : uint64_t((now - _start) / _tick);
+    for (;;) {
+        if (_heads[DUE_SLOT] != NIL) {
+            expire(DUE_SLOT, target);
+        } else {
+            uint64_t tick;
+            std::size_t slot;
+            if (!next_tick(tick, slot) || tick > target) break;
+            _now = tick;
+            expire(slot, target);
+        }
+        if (_firing.empty()) continue;
+        // Run the handlers unlocked so that they can schedule timers
+        std::vector<Firing> firing;
+        firing.swap(_firing);
+        lock.unlock();
+        for (std::size_t i = 0; i < firing.size(); i++) firing[i].handler(firing[i].due);
+        fired += firing.size();
+        firing.clear();
+        lock.lock();
+        if (_firing.empty()) _firing.swap(firing);
+    }
+    if (target > _now) _now = target;
+    return fired;
+}
+
+boost::optional<EventClock::time_point> TimerWheel::next_expiry() const {
+    boost::mutex::scoped_lock lock(_mutex);
+    if (_heads[DUE_SLOT] != NIL) return to_time(_now);
+    uint64_t tick;
+    std::size_t slot;
+    if (!next_tick(tick, slot)) return boost::optional<EventClock::time_point>();
+    return to_time(tick);
+}
+
+std::size_t TimerWheel::size() const {
+    boost::mutex::scoped_lock lock(_mutex);
+    return _size;
+}
+
+void TimerWheel::set_wake(std::tr1::function<void ()> wake) {
+    boost::mutex::scoped_lock lock(_mutex);
+    _wake = wake;
+}
+
+// Round up, so that a timer never fires early
+uint64_t TimerWheel::to_tick(EventClock::time_point time) const {
+    if (time <= _start) return 0;
+    return uint64_t((time - _start + _tick - EventClock::duration(1)) / _tick);
+}
+
+EventClock::time_point TimerWheel::to_time(uint64_t tick) const {
+    return _start + _tick * EventClock::rep(tick);
+}
+
+// Place a timer on the coarsest wheel where its expiry differs from now
+void TimerWheel::insert(uint32_t index) {
+    uint64_t expiry = _timers[index].expiry;
+    if (expiry <= _now) {
+        link(index, DUE_SLOT);
+        return;
+    }
+    uint64_t differ = expiry ^ _now;
+    std::size_t level = (63 - __builtin_clzll(differ)) / SLOT_BITS;
+    if (level >= TIMER_LEVELS) {
+        // Beyond the outermost wheel; park in its last slot and re-insert from there
+        level = TIMER_LEVELS - 1;
+        link(index, level * TIMER_SLOTS + TIMER_SLOTS - 1);
+        return;
+    }
+    link(index, level * TIMER_SLOTS + level_index(expiry, level));
+}
+
+void TimerWheel::link(uint32_t index, std::size_t slot) {
+    Timer& timer = _timers[index];
+    timer.slot = slot;
+    timer.prev = NIL;
+    timer.next = _heads[slot];
+    if (timer.next != NIL) _timers[timer.next].prev = index;
+    _heads[slot] = index;
+    if (slot < DUE_SLOT) {
+        _occupied[slot / TIMER_SLOTS][(slot % TIMER_SLOTS) / 64] |= uint64_t(1) << (slot % 64);
+    }
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Timer& timer = _timers[index];
+    if (timer.prev != NIL) _timers[timer.prev].next = timer.next;
+    else _heads[timer.slot] = timer.next;
+    if (timer.next != NIL) _timers[timer.next].prev = timer.prev;
+    if (_heads[timer.slot] == NIL && timer.slot < DUE_SLOT) {
+        std::size_t slot = timer.slot;
+        _occupied[slot / TIMER_SLOTS][(slot % TIMER_SLOTS) / 64] &= ~(uint64_t(1) << (slot % 64));
+    }
+    timer.prev = NIL;
+    timer.next = NIL;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Timer& timer = _timers[index];
+    timer.handler = Handler();
+    timer.generation++;
+    if (timer.generation == 0) timer.generation = 1;
+    _free.push_back(index);
+    _size--;
+}
+
+// Next tick at which a slot must be processed: the first occupied slot past
+// the current position on the finest wheel that has one
+bool TimerWheel::next_tick(uint64_t& tick, std::size_t& slot) const {
+    for (std::size_t level = 0; level < TIMER_LEVELS; level++) {
+        std::size_t from = level_index(_now, level) + 1;
+        for (std::size_t i = from; i < TIMER_SLOTS; ) {
+            uint64_t word = _occupied[level][i / 64] >> (i % 64);
+            if (word == 0) {
+                i = (i / 64 + 1) * 64;
+                continue;
+            }
+            i += __builtin_ctzll(word);
+            std::size_t shift = SLOT_BITS * level;
+            uint64_t block = shift + SLOT_BITS >= 64 ? 0 : (_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            tick = block | (uint64_t(i) << shift);
+            slot = level * TIMER_SLOTS + i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fire the due timers of a slot and move the rest down a wheel.  Periodic
+// timers are rescheduled past @c horizon, the tick being advanced to.
+void TimerWheel::expire(std::size_t slot, uint64_t horizon) {
+    uint32_t index = _heads[slot];
+    while (index != NIL) {
+        uint32_t next = _timers[index].next;
+        unlink(index);
+        Timer& timer = _timers[index];
+        if (timer.expiry > _now) {
+            insert(index);
+        } else {
+            Firing firing;
+            firing.handler = timer.handler;
+            firing.due = to_time(timer.expiry);
+            _firing.push_back(firing);
+            if (timer.period) {
+                timer.expiry += timer.period;
+                if (timer.expiry <= horizon) {
+                    timer.expiry += (horizon - timer.expiry) / timer.period * timer.period + timer.period;
+                }
+                insert(index);
+            } else {
+                release(index);
+            }
+        }
+        index = next;
+    }
+}
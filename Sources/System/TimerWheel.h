@@ -0,0 +1,164 @@
+#ifndef _TIMER_WHEEL_H
+#define _TIMER_WHEEL_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+#include <tr1/functional>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+#include <EventRouter.h>
+#include <Module.h>
+
+namespace j2 {
+
+    /** @brief Handle of a timer in a @c TimerWheel. */
+    typedef uint64_t TimerId;
+
+    /** @brief Id never returned for a timer. */
+    const TimerId NO_TIMER = 0;
+
+    /** @brief Default resolution of a @c TimerWheel. */
+    const boost::chrono::milliseconds DEFAULT_TIMER_TICK(1);
+
+    /**
+     * @brief Hierarchical timing wheel of one-shot and periodic timers.
+     *
+     * Time is divided into ticks.  Each of @c TIMER_LEVELS wheels has 256
+     * slots; a timer lives in the slot of the coarsest wheel on which its
+     * expiry differs from the current tick, and moves down a wheel each
+     * time the wheel above turns to its slot.  Scheduling and cancelling a
+     * timer is constant time, and @c advance skips empty stretches of the
+     * wheels, so thousands of timers cost no sorting and no threads.
+     *
+     * Timers never fire early, but may fire up to a tick late.  Handlers run
+     * on the thread calling @c advance, without the wheel's lock held, so they
+     * may schedule and cancel timers.  Every other member may be called from
+     * any thread.
+     */
+    class TimerWheel {
+    public:
+        /** @brief Called with the time the timer was due. */
+        typedef std::tr1::function<void (EventClock::time_point)> Handler;
+
+        static const std::size_t TIMER_LEVELS = 6;
+        static const std::size_t TIMER_SLOTS = 256;
+
+        /**
+         * @param tick resolution of the wheel
+         * @param start time of the first tick; times before it are due at once
+         */
+        explicit TimerWheel(EventClock::duration tick = DEFAULT_TIMER_TICK,
+                            EventClock::time_point start = EventClock::time_point());
+
+        /**
+         * @brief Run @c handler at @c when, then every @c period if it is
+         * not zero.  Periods missed while @c advance was not called are
+         * skipped rather than run back to back.
+         */
+        TimerId schedule(EventClock::time_point when, Handler handler,
+                         EventClock::duration period = EventClock::duration::zero());
+
+        /** @brief Run @c handler after @c delay, then every @c period if not zero. */
+        TimerId schedule_after(EventClock::duration delay, Handler handler,
+                               EventClock::duration period = EventClock::duration::zero()) {
+            return schedule(EventClock::now() + delay, handler, period);
+        }
+
+        /**
+         * @brief Stop a timer.
+         * @return whether the timer was still scheduled
+         */
+        bool cancel(TimerId id);
+
+        /**
+         * @brief Fire the timers due by @c now.
+         * @return number of handlers run
+         */
+        std::size_t advance(EventClock::time_point now = EventClock::now());
+
+        /**
+         * @brief Time by which @c advance must next be called.  May be
+         * earlier than the next expiry when timers need moving down a wheel.
+         */
+        boost::optional<EventClock::time_point> next_expiry() const;
+
+        /** @brief Number of scheduled timers. */
+        std::size_t size() const;
+
+        /**
+         * @brief Call @c wake whenever a timer is scheduled, so that a thread
+         * parked until @c next_expiry can recompute it.
+         */
+        void set_wake(std::tr1::function<void ()> wake);
+
+    private:
+        static const uint32_t NIL = uint32_t(-1);
+        static const std::size_t DUE_SLOT = TIMER_LEVELS * TIMER_SLOTS;
+        static const std::size_t SLOT_WORDS = TIMER_SLOTS / 64;
+
+        struct Timer {
+            // Generations start at one so that no timer has the id NO_TIMER
+            Timer() : generation(1), prev(NIL), next(NIL), slot(0), expiry(0), period(0) { }
+            uint32_t generation;
+            uint32_t prev;
+            uint32_t next;
+            std::size_t slot;
+            uint64_t expiry;        // Tick the timer is due
+            uint64_t period;        // Ticks between firings, or 0
+            Handler handler;
+        };
+
+        struct Firing {
+            Handler handler;
+            EventClock::time_point due;
+        };
+
+        uint64_t to_tick(EventClock::time_point time) const;
+        EventClock::time_point to_time(uint64_t tick) const;
+        void insert(uint32_t index);
+        void link(uint32_t index, std::size_t slot);
+        void unlink(uint32_t index);
+        void release(uint32_t index);
+        bool next_tick(uint64_t& tick, std::size_t& slot) const;
+        void expire(std::size_t slot, uint64_t horizon);
+
+        // Not copyable
+        TimerWheel(const TimerWheel&);
+        TimerWheel& operator=(const TimerWheel&);
+
+        const EventClock::duration _tick;
+        const EventClock::time_point _start;
+        uint64_t _now;
+        std::vector<Timer> _timers;
+        std::vector<uint32_t> _free;
+        uint32_t _heads[DUE_SLOT + 1];
+        uint64_t _occupied[TIMER_LEVELS][SLOT_WORDS];
+        std::size_t _size;
+        std::vector<Firing> _firing;
+        std::tr1::function<void ()> _wake;
+        mutable boost::mutex _mutex;
+    };
+
+    /** @brief Timer handler publishing the time a timer was due on a topic. */
+    struct PUBLISH_TIMER {
+        PUBLISH_TIMER(EventRouter& router, const std::string& topic) :
+            channel(router.channel<EventClock::time_point>(topic)) { }
+        void operator()(EventClock::time_point due) const { channel.publish(due); }
+        Channel<EventClock::time_point> channel;
+    };
+
+    /**
+     * @brief Timer handler posting a task to a module, so that the task runs
+     * on the module's thread in turn with its events.
+     */
+    struct POST_TIMER {
+        POST_TIMER(Module& module, Module::Task task) : module(&module), task(task) { }
+        void operator()(EventClock::time_point) const { module->post(task); }
+        Module* module;
+        Module::Task task;
+    };
+
+} // namespace j2
+
+#endif // _TIMER_WHEEL_H
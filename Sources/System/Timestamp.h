@@ -2,15 +2,19 @@
 #define _TIMESTAMP_H
 
 #include <cassert>
+#include <set>
+#include <vector>
+#include <algorithm>
 #include <boost/operators.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/chrono.hpp>
+#include "Clock.h"
 
 namespace j2 {
 
     class Timestampable {
     public:
-        typedef boost::chrono::high_resolution_clock Clock;
+        typedef j2::Clock Clock;
         typedef Clock::time_point Timestamp;
 
         Timestamp virtual timestamp() const = 0;
@@ -26,6 +30,44 @@ namespace j2 {
         bool operator<(const Timestampable& other) const {
             return timestamp() < other.timestamp();
         }
+
+        virtual ~Timestampable() { }
+    };
+
+    class TimestampSubject;
+
+    /**
+     * Told when the timestamp of an observed value changes, so that sets of
+     * values can be kept up to date without rescanning them
+     */
+    class TimestampObserver {
+    public:
+        virtual ~TimestampObserver() { }
+
+        virtual void retimestamped(Timestampable::Timestamp previous,
+                                   Timestampable::Timestamp current) = 0;
+
+        // The observed value is being destroyed
+        virtual void removed(TimestampSubject* subject,
+                             Timestampable::Timestamp timestamp) = 0;
+    };
+
+    /**
+     * Value that tells a single observer about changes to its timestamp
+     */
+    class TimestampSubject {
+    public:
+        TimestampSubject() : _observer(0) { }
+
+        void observe(TimestampObserver* observer) { _observer = observer; }
+
+    protected:
+        TimestampObserver* _observer;
+
+    private:
+        // Copies are not observed
+        TimestampSubject(const TimestampSubject&);
+        TimestampSubject& operator=(const TimestampSubject&);
     };
 
     /**
@@ -102,8 +144,97 @@ namespace j2 {
         std::vector<T*> _timestamps;
     };
 
+    /**
+     * Synchronized set of timestamped values that tracks its members'
+     * timestamps as they are assigned, rather than scanning the members.
+     * @c min, @c max and so @c is_synchronized are constant time, and
+     * assigning a member costs O(log n).  Members must be @c Timestamped
+     * values, each in at most one such set.
+     */
+    template <int TOLERANCE = 0,
+              class DURATION = boost::chrono::milliseconds>
+    class IncrementalTimestampedSet : public Timestampable, private TimestampObserver {
+    public:
+        IncrementalTimestampedSet() { }
+
+        ~IncrementalTimestampedSet() {
+            for (typename std::vector<TimestampSubject*>::iterator it = _members.begin();
+                 it != _members.end(); ++it) {
+                (*it)->observe(0);
+            }
+        }
+
+        template <typename U>
+        IncrementalTimestampedSet& add(U& timestamped) {
+            timestamped.observe(this);
+            _members.push_back(&timestamped);
+            _timestamps.insert(timestamped.timestamp());
+            return *this;
+        }
+
+        template <typename U>
+        IncrementalTimestampedSet& operator+=(U& timestamped) {
+            return add(timestamped);
+        }
+
+        template <typename U>
+        IncrementalTimestampedSet& operator,(U& timestamped) {
+            return add(timestamped);
+        }
+
+        Timestampable::Timestamp min() const {
+            if (_timestamps.empty()) return Timestampable::Timestamp::min();
+            return *_timestamps.begin();
+        }
+
+        Timestampable::Timestamp max() const {
+            if (_timestamps.empty()) return Timestampable::Timestamp::min();
+            return *_timestamps.rbegin();
+        }
+
+        template <class Rep, class Period>
+        boost::chrono::duration<Rep, Period> jitter() const {
+            return boost::chrono::duration<Rep,Period>(max() - min());
+        }
+
+        template <class Rep, class Period>
+        bool is_synchronized(boost::chrono::duration<Rep, Period> tolerance) const {
+            Timestampable::Timestamp min_timestamp = min();
+            return min_timestamp > Timestampable::Timestamp::min() &&
+                (max() - min_timestamp) <= tolerance;
+        }
+
+        bool is_synchronized() const {
+            return is_synchronized(DURATION(TOLERANCE));
+        }
+
+        // Returns the (most recent) timestamp for this set
+        virtual Timestampable::Timestamp timestamp() const {
+            return max();
+        }
+
+    private:
+        virtual void retimestamped(Timestampable::Timestamp previous,
+                                   Timestampable::Timestamp current) {
+            _timestamps.erase(_timestamps.find(previous));
+            _timestamps.insert(current);
+        }
+
+        virtual void removed(TimestampSubject* subject, Timestampable::Timestamp timestamp) {
+            _timestamps.erase(_timestamps.find(timestamp));
+            _members.erase(std::find(_members.begin(), _members.end(), subject));
+        }
+
+        // Not copyable
+        IncrementalTimestampedSet(const IncrementalTimestampedSet&);
+        IncrementalTimestampedSet& operator=(const IncrementalTimestampedSet&);
+
+        std::multiset<Timestampable::Timestamp> _timestamps;
+        std::vector<TimestampSubject*> _members;
+    };
+
     template <typename T>
-    class Timestamped : public Timestampable {
+    class Timestamped : public Timestampable, public TimestampSubject {
     public:
         typedef T value_type;
         typedef T& reference;
@@ -121,6 +252,25 @@ namespace j2 {
             _timestamp(timestampable.timestamp()),
             _value(value) { }
 
+        Timestamped(const Timestamped& other) :
+            Timestampable(),
+            TimestampSubject(),
+            _timestamp(other._timestamp),
+            _value(other._value) { }
+
+        ~Timestamped() {
+            if (_observer) _observer->removed(this, _timestamp);
+        }
+
+        // Assigns the value and timestamp, telling the observer if any
+        Timestamped& operator=(const Timestamped& other) {
+            Timestampable::Timestamp previous = _timestamp;
+            _value = other._value;
+            _timestamp = other._timestamp;
+            if (_observer && previous != _timestamp) _observer->retimestamped(previous, _timestamp);
+            return *this;
+        }
+
         operator value_type() { return _value; }
 
         const T* operator->() const { return &_value; } 
@@ -0,0 +1,133 @@
+#ifndef _TIMESTAMPED_HISTORY_H
+#define _TIMESTAMPED_HISTORY_H
+
+#include <cstddef>
+#include <boost/optional.hpp>
+#include "Timestamp.h"
+
+namespace j2 {
+
+    /**
+     * Value a fraction of the way from @c a to @c b.  Overload for types
+     * that do not support addition, subtraction and scaling by a double.
+     */
+    template <typename T>
+    T interpolate(const T& a, const T& b, double fraction) {
+        return a + (b - a) * fraction;
+    }
+
+    /**
+     * Fixed capacity history of the latest @c N samples of a timestamped
+     * value, kept in timestamp order in a ring buffer.
+     *
+     * Samples can be read at any time covered by the history, interpolating
+     * linearly between the samples either side, so that inputs arriving at
+     * different times can be combined at a common instant.
+     */
+    template <typename T, std::size_t N>
+    class TimestampedHistory : public Timestampable {
+    public:
+        typedef T value_type;
+
+        TimestampedHistory() : _head(0), _size(0) { }
+
+        /**
+         * Add a sample, dropping the oldest when full.  Samples older than
+         * the latest are inserted in timestamp order.
+         */
+        void push(const Timestamped<T>& sample) {
+            if (_size == N) {
+                if (sample.timestamp() < (*this)[0].timestamp()) return;
+                _head = (_head + 1) % N;
+                _size--;
+            }
+            std::size_t i = _size++;
+            while (i > 0 && sample.timestamp() < (*this)[i - 1].timestamp()) {
+                slot(i) = (*this)[i - 1];
+                i--;
+            }
+            slot(i) = sample;
+        }
+
+        /** Sample @c i, from 0 for the oldest to size() - 1 for the latest */
+        const Timestamped<T>& operator[](std::size_t i) const {
+            return _samples[(_head + i) % N];
+        }
+
+        const Timestamped<T>& latest() const { return (*this)[_size - 1]; }
+
+        std::size_t size() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+        std::size_t capacity() const { return N; }
+
+        void clear() {
+            _head = 0;
+            _size = 0;
+        }
+
+        /** Whether a sample at @c time can be read without extrapolating */
+        bool covers(Timestampable::Timestamp time) const {
+            return _size > 0 && time >= min() && time <= max();
+        }
+
+        /**
+         * Value at @c time, interpolated between the samples either side of
+         * it.  Empty if @c time is outside the history.
+         */
+        boost::optional<T> at(Timestampable::Timestamp time) const {
+            if (!covers(time)) return boost::optional<T>();
+            // First sample not before the time
+            std::size_t low = 0, high = _size - 1;
+            while (low < high) {
+                std::size_t mid = (low + high) / 2;
+                if ((*this)[mid].timestamp() < time) low = mid + 1;
+                else high = mid;
+            }
+            const Timestamped<T>& after = (*this)[low];
+            if (after.timestamp() == time || low == 0) return after.value();
+            const Timestamped<T>& before = (*this)[low - 1];
+            double fraction =
+                double((time - before.timestamp()).count()) /
+                double((after.timestamp() - before.timestamp()).count());
+            return interpolate(before.value(), after.value(), fraction);
+        }
+
+        /** Value at @c time, timestamped with that time */
+        boost::optional< Timestamped<T> > sample(Timestampable::Timestamp time) const {
+            boost::optional<T> value = at(time);
+            if (!value) return boost::optional< Timestamped<T> >();
+            return Timestamped<T>(*value, time);
+        }
+
+        // Timestamp of the latest sample
+        virtual Timestampable::Timestamp timestamp() const { return max(); }
+
+        virtual Timestampable::Timestamp min() const {
+            return empty() ? Timestampable::Timestamp::min() : (*this)[0].timestamp();
+        }
+
+        virtual Timestampable::Timestamp max() const {
+            return empty() ? Timestampable::Timestamp::min() : latest().timestamp();
+        }
+
+    private:
+        Timestamped<T>& slot(std::size_t i) { return _samples[(_head + i) % N]; }
+
+        Timestamped<T> _samples[N];
+        std::size_t _head;
+        std::size_t _size;
+    };
+
+    // Append a value delivered to a typed signal to a history.  This is used
+    // by Module::bind_value
+    template <typename T, std::size_t N> struct PUSH_TO_HISTORY {
+        PUSH_TO_HISTORY(TimestampedHistory<T, N>* history) : history(history) { }
+        void operator()(const Timestamped<T>& value) const { history->push(value); }
+        TimestampedHistory<T, N>* history;
+    };
+
+} // namespace j2
+
+#endif // _TIMESTAMPED_HISTORY_H
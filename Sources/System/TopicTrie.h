@@ -0,0 +1,156 @@
+#ifndef _TOPIC_TRIE_H
+#define _TOPIC_TRIE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <tr1/memory>
+
+namespace j2 {
+
+    /**
+     * @brief Split a hierarchical topic name into its '/' separated segments.
+     *
+     * A leading '/' produces an empty first segment, so "/motion/hoist" and
+     * "motion/hoist" are different topics.
+     */
+    inline std::vector<std::string> topic_segments(const std::string& name) {
+        std::vector<std::string> segments;
+        std::string::size_type start = 0;
+        for (;;) {
+            std::string::size_type end = name.find('/', start);
+            if (end == std::string::npos) {
+                segments.push_back(name.substr(start));
+                return segments;
+            }
+            segments.push_back(name.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    /**
+     * @brief Whether a topic name is a pattern rather than a literal topic.
+     *
+     * Within a pattern a segment of "*" matches exactly one segment of a
+     * topic name and a segment of "**" matches zero or more segments, so
+     * "/motion" followed by a "*" segment matches "/motion/hoist", and
+     * "/sensor" followed by a "**" segment matches both "/sensor" and
+     * "/sensor/inclinometer/pitch".
+     */
+    inline bool is_topic_pattern(const std::string& name) {
+        return name.find('*') != std::string::npos;
+    }
+
+    /**
+     * @brief Set of values keyed by topic pattern, searchable by topic name.
+     *
+     * Patterns are compiled into a trie of segments so that finding every
+     * pattern matching a name costs one walk of the name rather than one
+     * comparison per pattern.
+     *
+     * @tparam V type of value stored against each pattern; must be equality
+     *  comparable and less than comparable
+     */
+    template <typename V>
+    class TopicTrie {
+    public:
+        TopicTrie() : _root(new Node) { }
+
+        /** @brief Add a value to be returned for names matching @c pattern. */
+        void insert(const std::string& pattern, const V& value) {
+            std::vector<std::string> segments = topic_segments(pattern);
+            Node* node = _root.get();
+            for (std::vector<std::string>::const_iterator it = segments.begin();
+                 it != segments.end(); ++it) {
+                NodePtr& child = node->children[*it];
+                if (!child) child.reset(new Node);
+                node = child.get();
+            }
+            node->values.push_back(value);
+        }
+
+        /**
+         * @brief Remove a value previously inserted for @c pattern.
+         * @return whether the value was found
+         */
+        bool erase(const std::string& pattern, const V& value) {
+            std::vector<std::string> segments = topic_segments(pattern);
+            Node* node = _root.get();
+            for (std::vector<std::string>::const_iterator it = segments.begin();
+                 it != segments.end(); ++it) {
+                typename Children::iterator child = node->children.find(*it);
+                if (child == node->children.end()) return false;
+                node = child->second.get();
+            }
+            typename std::vector<V>::iterator it =
+                std::find(node->values.begin(), node->values.end(), value);
+            if (it == node->values.end()) return false;
+            node->values.erase(it);
+            return true;
+        }
+
+        /**
+         * @brief Find the values of every pattern matching a topic name.
+         * @param name literal topic name
+         * @param out receives each matching value once, in no particular order
+         */
+        void match(const std::string& name, std::vector<V>& out) const {
+            std::vector<std::string> segments = topic_segments(name);
+            std::vector<V> found;
+            match(*_root, segments, 0, found);
+            // Patterns with several "**" segments can match a name more than once
+            std::sort(found.begin(), found.end());
+            found.erase(std::unique(found.begin(), found.end()), found.end());
+            out.insert(out.end(), found.begin(), found.end());
+        }
+
+        /** @brief Whether @c name matches a single @c pattern. */
+        static bool matches(const std::string& pattern, const std::string& name) {
+            TopicTrie<int> trie;
+            trie.insert(pattern, 1);
+            std::vector<int> found;
+            trie.match(name, found);
+            return !found.empty();
+        }
+
+    private:
+        struct Node;
+        typedef std::tr1::shared_ptr<Node> NodePtr;
+        typedef std::map<std::string, NodePtr> Children;
+
+        struct Node {
+            Children children;
+            std::vector<V> values;
+        };
+
+        static void match(const Node& node,
+                          const std::vector<std::string>& segments,
+                          std::size_t i,
+                          std::vector<V>& out) {
+            typename Children::const_iterator any_depth = node.children.find("**");
+            if (any_depth != node.children.end()) {
+                for (std::size_t j = i; j <= segments.size(); j++) {
+                    match(*any_depth->second, segments, j, out);
+                }
+            }
+            if (i == segments.size()) {
+                out.insert(out.end(), node.values.begin(), node.values.end());
+                return;
+            }
+            typename Children::const_iterator exact = node.children.find(segments[i]);
+            if (exact != node.children.end()) {
+                match(*exact->second, segments, i + 1, out);
+            }
+            typename Children::const_iterator any = node.children.find("*");
+            if (any != node.children.end()) {
+                match(*any->second, segments, i + 1, out);
+            }
+        }
+
+        NodePtr _root;
+    };
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/thread/tss.hpp>
+#include "WorkerPool.h"
+
+using namespace j2;
+
+namespace {
+    // Worker running on the current thread, so that modules made ready by a
+    // worker are pushed onto its own run queue
+    struct WorkerContext {
+        WorkerContext(const WorkerPool* pool, std::size_t index) :
+            pool(pool), index(index) { }
+        const WorkerPool* pool;
+        std::size_t index;
+    };
+
+    boost::thread_specific_ptr<WorkerContext> current_worker;
+}
+
+WorkerPool::WorkerPool(int batch) :
+    _batch(batch),
+    _queued(0),
+    _next(0),
+    _running(false) {
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start(std::size_t threads) {
+    if (_running.load()) throw std::logic_error("worker pool is already running");
+    if (threads == 0) threads = 1;
+    _workers.clear();
+    for (std::size_t i = 0; i < threads; i++) {
+        _workers.push_back(std::tr1::shared_ptr<Worker>(new Worker));
+    }
+    _queued.store(0);
+    _running.store(true);
+    for (std::size_t i = 0; i < _actors.size(); i++) {
+        Actor* actor = _actors[i].get();
+        actor->scheduled.store(false);
+        actor->module->add_ready_listener(actor);
+        if (actor->module->is_ready()) schedule(actor);
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        _threads.create_thread(boost::bind(&WorkerPool::run, this, i));
+    }
+}
+
+void WorkerPool::stop() {
+    if (!_running.exchange(false)) return;
+    for (std::size_t i = 0; i < _actors.size(); i++) {
+        _actors[i]->module->remove_ready_listener(_actors[i].get());
+    }
+    _work.notify();
+    _threads.join_all();
+}
+
+void WorkerPool::add(boost::shared_ptr<Module> module) {
+    std::tr1::shared_ptr<Actor> actor(new Actor(*this, module));
+    _actors.push_back(actor);
+    if (_running.load()) {
+        module->add_ready_listener(actor.get());
+        if (module->is_ready()) schedule(actor.get());
+    }
+}
+
+void WorkerPool::schedule(Actor* actor) {
+    if (!actor->scheduled.exchange(true)) push(actor);
+}
+
+void WorkerPool::push(Actor* actor) {
+    WorkerContext* context = current_worker.get();
+    std::size_t index = context && context->pool == this
+        ? context->index
+        : _next.fetch_add(1, boost::memory_order_relaxed) % _workers.size();
+    Worker& worker = *_workers[index];
+    {
+        boost::mutex::scoped_lock lock(worker.mutex);
+        worker.runnable.push_back(actor);
+    }
+    _queued.fetch_add(1);
+    _work.notify();
+}
+
+WorkerPool::Actor* WorkerPool::pop(std::size_t index) {
+    std::size_t count = _workers.size();
+    for (std::size_t i = 0; i < count; i++) {
+        Worker& worker = *_workers[(index + i) % count];
+        boost::mutex::scoped_lock lock(worker.mutex);
+        if (worker.runnable.empty()) continue;
+        Actor* actor;
+        // Take our own oldest module, or steal the newest from another worker
+        if (i == 0) {
+            actor = worker.runnable.front();
+            worker.runnable.pop_front();
+        } else {
+            actor = worker.runnable.back();
+            worker.runnable.pop_back();
+        }
+        _queued.fetch_sub(1);
+        return actor;
+    }
+    return 0;
+}
+
+void WorkerPool::execute(Actor* actor) {
+    actor->module->process(_batch);
+    // Clear the flag before looking at the queue, so that an event arriving
+    // in between either is seen here or reschedules the module itself
+    actor->scheduled.store(false);
+    if (actor->module->is_ready()) schedule(actor);
+}
+
+bool WorkerPool::has_work() const {
+    return _queued.load() > 0 || !_running.load();
+}
+
+void WorkerPool::run(std::size_t index) {
+    current_worker.reset(new WorkerContext(this, index));
+    while (_running.load()) {
+        Actor* actor = pop(index);
+        if (actor) {
+            execute(actor);
+        } else {
+            _work.wait(boost::bind(&WorkerPool::has_work, this));
+        }
+    }
+    current_worker.reset();
+}
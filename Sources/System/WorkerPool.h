@@ -0,0 +1,101 @@
+#ifndef _WORKER_POOL_H
+#define _WORKER_POOL_H
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <tr1/memory>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <Module.h>
+#include <ring_queue.h>
+
+namespace j2 {
+
+    /** @brief Number of events a worker delivers to a module before moving on. */
+    const int DEFAULT_WORKER_BATCH = 32;
+
+    /**
+     * @brief Pool of worker threads running modules as actors.
+     *
+     * A module is pushed onto a worker's run queue when its @c EventQueue goes
+     * from empty to non-empty.  Each worker takes modules from the front of its
+     * own run queue and, once that is empty, steals from the back of the
+     * others', so independent modules spread over every thread.  A module is
+     * on at most one run queue at a time and so only ever runs on one thread
+     * at a time; modules need no locking of their own.
+     *
+     * Modules that become ready while a worker runs are pushed onto that
+     * worker's run queue, keeping a chain of modules on the thread whose
+     * caches hold its events.
+     */
+    class WorkerPool {
+    public:
+        explicit WorkerPool(int batch = DEFAULT_WORKER_BATCH);
+
+        ~WorkerPool();
+
+        /**
+         * @brief Run modules on @c threads worker threads.
+         * @throws std::logic_error if the pool is already running
+         */
+        void start(std::size_t threads);
+
+        /**
+         * @brief Stop and join the worker threads.  Modules stop being told
+         * about new events, so they can be scheduled by other means again.
+         */
+        void stop();
+
+        bool is_running() const { return _running.load(); }
+
+        /** @brief Number of worker threads. */
+        std::size_t size() const { return _workers.size(); }
+
+        /** @brief Run a module whenever it has events. */
+        void add(boost::shared_ptr<Module> module);
+
+    private:
+        class Actor : public ReadyListener {
+        public:
+            Actor(WorkerPool& pool, boost::shared_ptr<Module> module) :
+                pool(pool), module(module), scheduled(false) { }
+
+            virtual void ready(EventQueue&) { pool.schedule(this); }
+
+            WorkerPool& pool;
+            boost::shared_ptr<Module> module;
+            // Set while the actor is on a run queue or being run
+            boost::atomic<bool> scheduled;
+        };
+
+        struct Worker {
+            boost::mutex mutex;
+            std::deque<Actor*> runnable;
+        };
+
+        void schedule(Actor* actor);
+        void push(Actor* actor);
+        Actor* pop(std::size_t index);
+        void execute(Actor* actor);
+        void run(std::size_t index);
+        bool has_work() const;
+
+        // Not copyable
+        WorkerPool(const WorkerPool&);
+        WorkerPool& operator=(const WorkerPool&);
+
+        const int _batch;
+        std::vector<std::tr1::shared_ptr<Actor> > _actors;
+        std::vector<std::tr1::shared_ptr<Worker> > _workers;
+        boost::thread_group _threads;
+        boost::atomic<std::size_t> _queued;
+        boost::atomic<std::size_t> _next;
+        boost::atomic<bool> _running;
+        adaptive_wait _work;
+    };
+
+} // namespace j2
+
+#endif // _WORKER_POOL_H
@@ -2,11 +2,28 @@
 #define _BLOCKING_QUEUE
 
 #include <queue>
+#include <stdexcept>
 #include <tr1/memory>
+#include <boost/chrono.hpp>
+#include <boost/optional.hpp>
 #include <boost/thread.hpp>
 
 namespace j2 {
 
+/** @brief Thrown when using a @c blocking_queue that has been closed. */
+class queue_closed : public std::runtime_error {
+public:
+    queue_closed() : std::runtime_error("queue closed") { }
+};
+
+/**
+ * @brief Queue that blocks consumers until an item is available.
+ *
+ * @c close releases every waiting consumer: items already queued can still
+ * be dequeued, after which @c deq throws @c queue_closed and the timed and
+ * batch operations return nothing.  Enqueueing on a closed queue throws
+ * @c queue_closed.
+ */
 template<typename _Tp, class _Sequence = std::queue<_Tp> >
 class blocking_queue {
 public:
@@ -20,30 +37,118 @@ public:
     typedef boost::shared_lock<Mutex> ReadLock;
     typedef boost::unique_lock<Mutex> WriteLock;
     
-    blocking_queue() { }
+    blocking_queue() : _closed(false) { }
 
     explicit
-    blocking_queue(const _Sequence& sequence) : _queue(sequence) { }
+    blocking_queue(const _Sequence& sequence) : _queue(sequence), _closed(false) { }
 
-    // TODO: Support timeout
+    /**
+     * @brief Wait for an item and dequeue it.
+     * @throws queue_closed if the queue is closed and empty
+     */
     value_type deq() {
         WriteLock lock(_mutex);
-        while(_queue.empty()) { _not_empty.wait(lock); }
-        const_reference result = _queue.front();
+        while (_queue.empty() && !_closed) { _not_empty.wait(lock); }
+        if (_queue.empty()) throw queue_closed();
+        value_type result = _queue.front();
         _queue.pop();
         return result;
     }
 
+    /**
+     * @brief Wait up to @c timeout for an item and dequeue it.
+     * @return the item, or nothing if the wait timed out or the queue is
+     *  closed and empty
+     */
+    template <class Rep, class Period>
+    boost::optional<value_type> deq_for(const boost::chrono::duration<Rep, Period>& timeout) {
+        return deq_until(boost::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Wait until @c deadline for an item and dequeue it.
+     * @return the item, or nothing if the deadline passed or the queue is
+     *  closed and empty
+     */
+    template <class Clock, class Duration>
+    boost::optional<value_type> deq_until(const boost::chrono::time_point<Clock, Duration>& deadline) {
+        WriteLock lock(_mutex);
+        while (_queue.empty() && !_closed) {
+            if (_not_empty.wait_until(lock, deadline) == boost::cv_status::timeout) break;
+        }
+        if (_queue.empty()) return boost::optional<value_type>();
+        boost::optional<value_type> result(_queue.front());
+        _queue.pop();
+        return result;
+    }
+
+    /**
+     * @brief Wait for at least one item, then dequeue every queued item
+     * with a single lock acquisition.
+     * @param out output iterator receiving the items
+     * @return number of items dequeued, which is zero only once the queue is
+     *  closed and empty
+     */
+    template <class OutputIterator>
+    size_type deq_all(OutputIterator out) {
+        WriteLock lock(_mutex);
+        while (_queue.empty() && !_closed) { _not_empty.wait(lock); }
+        size_type count = 0;
+        for (; !_queue.empty(); count++) {
+            *out++ = _queue.front();
+            _queue.pop();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Wait for at least one item, then dequeue up to @c n items with
+     * a single lock acquisition.
+     * @param n maximum number of items to dequeue
+     * @param out output iterator receiving the items
+     * @return number of items dequeued, which is zero only if @c n is zero or
+     *  the queue is closed and empty
+     */
+    template <class OutputIterator>
+    size_type deq_up_to(size_type n, OutputIterator out) {
+        if (n == 0) return 0;
+        WriteLock lock(_mutex);
+        while (_queue.empty() && !_closed) { _not_empty.wait(lock); }
+        size_type count = 0;
+        for (; count < n && !_queue.empty(); count++) {
+            *out++ = _queue.front();
+            _queue.pop();
+        }
+        return count;
+    }
+
     void push(const value_type& item) {
         enq(item);
     }
 
+    /**
+     * @brief Enqueue an item, waking a waiting consumer.
+     * @throws queue_closed if the queue is closed
+     */
     void enq(const value_type& item) {
         WriteLock lock(_mutex);
+        if (_closed) throw queue_closed();
         _queue.push(item);
         _not_empty.notify_one();
     }
 
+    /** @brief Close the queue, releasing every waiting consumer. */
+    void close() {
+        WriteLock lock(_mutex);
+        _closed = true;
+        _not_empty.notify_all();
+    }
+
+    bool is_closed() const {
+        ReadLock lock(_mutex);
+        return _closed;
+    }
+
     size_type size() const {
         ReadLock lock(_mutex);
         return _queue.size();
@@ -58,6 +163,7 @@ protected:
     _Sequence _queue;
     mutable Mutex _mutex;
     boost::condition_variable_any _not_empty;
+    bool _closed;
 };
 
 } // namespace j2
@@ -0,0 +1,346 @@
+#ifndef _RING_QUEUE
+#define _RING_QUEUE
+
+#include <cstddef>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread.hpp>
+
+namespace j2 {
+
+/**
+ * @brief Wait strategy that spins, then yields, then parks on a condition
+ * variable until a predicate holds.
+ *
+ * The number of spins adapts: it grows while waits are satisfied by spinning
+ * and shrinks when the waiter has to park, so a busy queue is drained without
+ * sleeping while an idle one does not burn CPU.  @c notify only takes the
+ * mutex when a waiter is parked, so it costs a single atomic load otherwise.
+ */
+class adaptive_wait {
+public:
+    static const unsigned MIN_SPINS = 16;
+    static const unsigned MAX_SPINS = 4096;
+    static const unsigned YIELDS = 8;
+
+    adaptive_wait() : _spins(MIN_SPINS * 4), _parked(0) { }
+
+    template <typename Predicate>
+    void wait(Predicate ready) {
+        unsigned spins = _spins.load(boost::memory_order_relaxed);
+        for (unsigned i = 0; i < spins; i++) {
+            if (ready()) {
+                if (spins < MAX_SPINS) _spins.store(spins * 2, boost::memory_order_relaxed);
+                return;
+            }
+            relax();
+        }
+        for (unsigned i = 0; i < YIELDS; i++) {
+            if (ready()) return;
+            boost::this_thread::yield();
+        }
+        if (spins > MIN_SPINS) _spins.store(spins / 2, boost::memory_order_relaxed);
+
+        boost::unique_lock<boost::mutex> lock(_mutex);
+        _parked.fetch_add(1, boost::memory_order_seq_cst);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        while (!ready()) _wake.wait(lock);
+        _parked.fetch_sub(1, boost::memory_order_relaxed);
+    }
+
+    /** @brief Wake parked waiters; call after making the predicate true. */
+    void notify() {
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (_parked.load(boost::memory_order_relaxed) == 0) return;
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        _wake.notify_all();
+    }
+
+private:
+    static void relax() {
+#if defined(__i386__) || defined(__x86_64__)
+        __asm__ __volatile__("pause");
+#endif
+    }
+
+    boost::atomic<unsigned> _spins;
+    boost::atomic<unsigned> _parked;
+    boost::mutex _mutex;
+    boost::condition_variable _wake;
+};
+
+/** @brief Default capacity of @c spsc_queue and @c mpsc_queue. */
+const std::size_t DEFAULT_RING_QUEUE_CAPACITY = 1024;
+
+// Round up to a power of two
+inline std::size_t ring_queue_capacity(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    return size;
+}
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one
+ * consumer thread.
+ *
+ * Offers the same @c enq / @c deq interface as @c blocking_queue; @c enq
+ * waits while the queue is full and @c deq waits while it is empty, using an
+ * @c adaptive_wait so that neither takes a lock while the other side keeps
+ * up.  @c _Tp must be default constructible and assignable.
+ */
+template<typename _Tp>
+class spsc_queue {
+public:
+    typedef _Tp             value_type;
+    typedef std::size_t     size_type;
+
+    explicit
+    spsc_queue(size_type capacity = DEFAULT_RING_QUEUE_CAPACITY) :
+        _capacity(ring_queue_capacity(capacity)),
+        _ring(new value_type[_capacity]),
+        _head(0),
+        _tail(0) { }
+
+    /** @brief Enqueue an item if there is room, without waiting. */
+    bool try_enq(const value_type& item) {
+        size_type tail = _tail.load(boost::memory_order_relaxed);
+        if (tail - _head.load(boost::memory_order_acquire) == _capacity) return false;
+        _ring[tail & (_capacity - 1)] = item;
+        _tail.store(tail + 1, boost::memory_order_release);
+        _not_empty.notify();
+        return true;
+    }
+
+    void enq(const value_type& item) {
+        while (!try_enq(item)) {
+            _not_full.wait(boost::bind(&spsc_queue::not_full, this));
+        }
+    }
+
+    void push(const value_type& item) {
+        enq(item);
+    }
+
+    /** @brief Dequeue an item if one is available, without waiting. */
+    bool try_deq(value_type& item) {
+        size_type head = _head.load(boost::memory_order_relaxed);
+        if (head == _tail.load(boost::memory_order_acquire)) return false;
+        item = _ring[head & (_capacity - 1)];
+        _head.store(head + 1, boost::memory_order_release);
+        _not_full.notify();
+        return true;
+    }
+
+    value_type deq() {
+        value_type item;
+        while (!try_deq(item)) {
+            _not_empty.wait(boost::bind(&spsc_queue::not_empty, this));
+        }
+        return item;
+    }
+
+    /**
+     * @brief Wait for at least one item, then dequeue up to @c n items.
+     * @param out output iterator receiving the items
+     * @return number of items dequeued
+     */
+    template <typename OutputIterator>
+    size_type deq_n(OutputIterator out, size_type n) {
+        if (n == 0) return 0;
+        _not_empty.wait(boost::bind(&spsc_queue::not_empty, this));
+        size_type head = _head.load(boost::memory_order_relaxed);
+        size_type available = _tail.load(boost::memory_order_acquire) - head;
+        size_type count = available < n ? available : n;
+        for (size_type i = 0; i < count; i++) {
+            *out++ = _ring[(head + i) & (_capacity - 1)];
+        }
+        _head.store(head + count, boost::memory_order_release);
+        _not_full.notify();
+        return count;
+    }
+
+    /** @brief Number of queued items; only a snapshot while other threads run. */
+    size_type size() const {
+        return _tail.load(boost::memory_order_acquire) - _head.load(boost::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_type capacity() const { return _capacity; }
+
+private:
+    bool not_empty() const { return !empty(); }
+
+    bool not_full() const { return size() < _capacity; }
+
+    // Not copyable
+    spsc_queue(const spsc_queue&);
+    spsc_queue& operator=(const spsc_queue&);
+
+    const size_type _capacity;
+    boost::scoped_array<value_type> _ring;
+    // Keep the consumer and producer indices on separate cache lines
+    char _pad0[64];
+    boost::atomic<size_type> _head;
+    char _pad1[64];
+    boost::atomic<size_type> _tail;
+    char _pad2[64];
+    adaptive_wait _not_empty;
+    adaptive_wait _not_full;
+};
+
+/**
+ * @brief Bounded lock-free queue for any number of producer threads and one
+ * consumer thread.
+ *
+ * Each slot carries a sequence number recording whether it is free for the
+ * producer claiming that position or filled for the consumer, so producers
+ * only contend on a compare-and-swap of the tail and the consumer never
+ * contends at all.  Otherwise behaves as @c spsc_queue.
+ */
+template<typename _Tp>
+class mpsc_queue {
+public:
+    typedef _Tp             value_type;
+    typedef std::size_t     size_type;
+
+    explicit
+    mpsc_queue(size_type capacity = DEFAULT_RING_QUEUE_CAPACITY) :
+        _capacity(ring_queue_capacity(capacity)),
+        _cells(new Cell[_capacity]),
+        _head(0),
+        _tail(0) {
+        for (size_type i = 0; i < _capacity; i++) {
+            _cells[i].sequence.store(i, boost::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Enqueue an item if there is room, without waiting. */
+    bool try_enq(const value_type& item) {
+        size_type pos = _tail.load(boost::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[pos & (_capacity - 1)];
+            size_type sequence = cell->sequence.load(boost::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.load(boost::memory_order_relaxed);
+            }
+        }
+        cell->value = item;
+        cell->sequence.store(pos + 1, boost::memory_order_release);
+        _not_empty.notify();
+        return true;
+    }
+
+    void enq(const value_type& item) {
+        while (!try_enq(item)) {
+            _not_full.wait(boost::bind(&mpsc_queue::not_full, this));
+        }
+    }
+
+    void push(const value_type& item) {
+        enq(item);
+    }
+
+    /** @brief Dequeue an item if one is available, without waiting. */
+    bool try_deq(value_type& item) {
+        size_type head = _head.load(boost::memory_order_relaxed);
+        Cell& cell = _cells[head & (_capacity - 1)];
+        if (cell.sequence.load(boost::memory_order_acquire) != head + 1) return false;
+        item = cell.value;
+        release(cell, head);
+        _head.store(head + 1, boost::memory_order_release);
+        _not_full.notify();
+        return true;
+    }
+
+    value_type deq() {
+        value_type item;
+        while (!try_deq(item)) {
+            _not_empty.wait(boost::bind(&mpsc_queue::not_empty, this));
+        }
+        return item;
+    }
+
+    /**
+     * @brief Wait for at least one item, then dequeue up to @c n items.
+     * @param out output iterator receiving the items
+     * @return number of items dequeued
+     */
+    template <typename OutputIterator>
+    size_type deq_n(OutputIterator out, size_type n) {
+        if (n == 0) return 0;
+        _not_empty.wait(boost::bind(&mpsc_queue::not_empty, this));
+        size_type head = _head.load(boost::memory_order_relaxed);
+        size_type count = 0;
+        while (count < n) {
+            Cell& cell = _cells[(head + count) & (_capacity - 1)];
+            if (cell.sequence.load(boost::memory_order_acquire) != head + count + 1) break;
+            *out++ = cell.value;
+            release(cell, head + count);
+            count++;
+        }
+        _head.store(head + count, boost::memory_order_release);
+        _not_full.notify();
+        return count;
+    }
+
+    /** @brief Number of queued items; only a snapshot while other threads run. */
+    size_type size() const {
+        size_type head = _head.load(boost::memory_order_acquire);
+        size_type tail = _tail.load(boost::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const {
+        return !not_empty();
+    }
+
+    size_type capacity() const { return _capacity; }
+
+private:
+    struct Cell {
+        boost::atomic<size_type> sequence;
+        value_type value;
+    };
+
+    // Hand a consumed cell back to the producer one lap ahead
+    void release(Cell& cell, size_type pos) {
+        cell.sequence.store(pos + _capacity, boost::memory_order_release);
+    }
+
+    // Whether the next cell has been filled; a producer may have claimed a
+    // position without filling it yet, so the tail alone is not enough
+    bool not_empty() const {
+        size_type head = _head.load(boost::memory_order_relaxed);
+        return _cells[head & (_capacity - 1)].sequence.load(boost::memory_order_acquire) == head + 1;
+    }
+
+    bool not_full() const { return size() < _capacity; }
+
+    // Not copyable
+    mpsc_queue(const mpsc_queue&);
+    mpsc_queue& operator=(const mpsc_queue&);
+
+    const size_type _capacity;
+    boost::scoped_array<Cell> _cells;
+    char _pad0[64];
+    boost::atomic<size_type> _head;
+    char _pad1[64];
+    boost::atomic<size_type> _tail;
+    char _pad2[64];
+    adaptive_wait _not_empty;
+    adaptive_wait _not_full;
+};
+
+} // namespace j2
+
+#endif // _RING_QUEUE
@@ -0,0 +1,255 @@
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include "ModbusClient.h"
+#include "ModbusLoopbackServer.h"
+
+using namespace std;
+using namespace j2;
+
+static void record(vector<ModbusTcpMessage>* responses, const ModbusTcpMessage& response) {
+    responses->push_back(response);
+}
+
+// Run the reactor until the expected number of responses have arrived
+static void wait_for(Reactor& reactor, const vector<ModbusTcpMessage>& responses, size_t count) {
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (responses.size() < count && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(50)));
+    }
+}
+
+TEST(ModbusClient, matches_pipelined_responses_by_transaction_id) {
+    ModbusLoopbackServer server;
+    server.set_reverse_batch(4);
+    Reactor reactor;
+    ModbusClient client(reactor, 1, 4);
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    vector<uint16_t> ids;
+    for (uint16_t i = 0; i < 4; i++) {
+        ids.push_back(client.request(ReadHoldingRegistersRequest(i * 10, 2),
+                                     boost::bind(record, &responses, _1)));
+    }
+    EXPECT_EQ(4u, client.outstanding());
+    wait_for(reactor, responses, 4);
+
+    // The server answers newest first
+    ASSERT_EQ(4u, responses.size());
+    for (size_t i = 0; i < 4; i++) {
+        const ModbusTcpMessage& response = responses[i];
+        EXPECT_EQ(ids[3 - i], response.transactionId);
+        EXPECT_FALSE(response.isException());
+        const vector<uint16_t>& registers = response.message<ReadHoldingRegistersResponse>().registers;
+        ASSERT_EQ(2u, registers.size());
+        EXPECT_EQ((3 - i) * 10, registers[0]);
+        EXPECT_EQ((3 - i) * 10 + 1, registers[1]);
+    }
+    EXPECT_EQ(0u, client.outstanding());
+    EXPECT_EQ(4u, client.stats().responses);
+}
+
+TEST(ModbusClient, queues_requests_beyond_the_pipeline) {
+    ModbusLoopbackServer server;
+    Reactor reactor;
+    ModbusClient client(reactor, 1, 2);
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    for (uint16_t i = 0; i < 10; i++) {
+        client.request(ReadHoldingRegistersRequest(i, 1), boost::bind(record, &responses, _1));
+    }
+    EXPECT_EQ(2u, client.outstanding());
+    EXPECT_EQ(8u, client.queued());
+    wait_for(reactor, responses, 10);
+
+    ASSERT_EQ(10u, responses.size());
+    for (size_t i = 0; i < responses.size(); i++) {
+        EXPECT_EQ(i, responses[i].message<ReadHoldingRegistersResponse>().registers[0]);
+    }
+    EXPECT_EQ(10u, server.requests());
+}
+
+TEST(ModbusClient, writes_registers_and_reports_exceptions) {
+    ModbusLoopbackServer server(16);
+    Reactor reactor;
+    ModbusClient client(reactor);
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    vector<uint16_t> registers(3, 0xbeef);
+    client.request(WriteMultipleRegistersRequest(4, registers), boost::bind(record, &responses, _1));
+    client.request(ReadHoldingRegistersRequest(14, 4), boost::bind(record, &responses, _1));
+    wait_for(reactor, responses, 2);
+
+    ASSERT_EQ(2u, responses.size());
+    EXPECT_EQ(3, responses[0].message<WriteMultipleRegistersResponse>().numberOfRegisters);
+    EXPECT_EQ(0xbeef, server.image().get<uint16_t>(6));
+    ASSERT_TRUE(responses[1].isException());
+    EXPECT_EQ(ReadHoldingRegisters | MODBUS_EXCEPTION_FLAG, responses[1].functionCode);
+    EXPECT_EQ(IllegalDataAddress, responses[1].message<ModbusExceptionMessage>().exception());
+}
+
+static void record_pdu(vector<pair<uint16_t, ModbusPdu> >* responses,
+                       uint16_t transactionId, const ModbusPdu& response) {
+    responses->push_back(make_pair(transactionId, response));
+}
+
+TEST(ModbusClient, requests_and_decodes_pdus) {
+    ModbusLoopbackServer server(64);
+    Reactor reactor;
+    ModbusClient client(reactor, 1, 2, boost::chrono::milliseconds(100));
+    client.connect("127.0.0.1", server.port());
+
+    vector<pair<uint16_t, ModbusPdu> > responses;
+    vector<uint16_t> ids;
+    for (uint16_t i = 0; i < 3; i++) {
+        ModbusPdu request;
+        ModbusPdu::ReadRequest& read = request.make_read_request();
+        read.startingAddress = uint16_t(i * 10);
+        read.numberOfRegisters = 2;
+        ids.push_back(client.request_pdu(request, boost::bind(record_pdu, &responses, _1, _2)));
+    }
+    EXPECT_EQ(2u, client.outstanding());
+    EXPECT_EQ(1u, client.queued());
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (responses.size() < 3 && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(50)));
+    }
+
+    ASSERT_EQ(3u, responses.size());
+    for (size_t i = 0; i < responses.size(); i++) {
+        EXPECT_EQ(ids[i], responses[i].first);
+        ASSERT_EQ(ModbusPdu::ReadHoldingRegistersResponsePdu, responses[i].second.kind());
+        const ModbusPdu::ReadResponse& read = responses[i].second.read_response();
+        ASSERT_EQ(2, read.numberOfRegisters);
+        EXPECT_EQ(i * 10, read.registers[0]);
+        EXPECT_EQ(i * 10 + 1, read.registers[1]);
+    }
+    EXPECT_EQ(0u, client.outstanding());
+
+    server.set_silent(true);
+    ModbusPdu request;
+    request.make_read_request().numberOfRegisters = 1;
+    uint16_t id = client.request_pdu(request, boost::bind(record_pdu, &responses, _1, _2));
+    EXPECT_EQ(1u, client.expire(EventClock::now() + boost::chrono::milliseconds(100)));
+    ASSERT_EQ(4u, responses.size());
+    EXPECT_EQ(id, responses[3].first);
+    ASSERT_EQ(ModbusPdu::ExceptionPdu, responses[3].second.kind());
+    EXPECT_EQ(GatewayTargetFailedToRespond, responses[3].second.exception().exception);
+    EXPECT_EQ(ReadHoldingRegisters | MODBUS_EXCEPTION_FLAG, responses[3].second.exception().functionCode);
+}
+
+TEST(ModbusClient, fails_requests_that_time_out_or_lose_the_connection) {
+    ModbusLoopbackServer server;
+    server.set_silent(true);
+    Reactor reactor;
+    ModbusClient client(reactor, 1, 1, boost::chrono::milliseconds(100));
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    client.request(ReadHoldingRegistersRequest(0, 1), boost::bind(record, &responses, _1));
+    client.request(ReadHoldingRegistersRequest(1, 1), boost::bind(record, &responses, _1));
+    EXPECT_EQ(0u, client.expire());
+    EXPECT_EQ(1u, client.expire(EventClock::now() + boost::chrono::milliseconds(100)));
+    ASSERT_EQ(1u, responses.size());
+    EXPECT_EQ(GatewayTargetFailedToRespond, responses[0].message<ModbusExceptionMessage>().exception());
+    EXPECT_EQ(1u, client.outstanding());
+
+    server.disconnect();
+    wait_for(reactor, responses, 2);
+    ASSERT_EQ(2u, responses.size());
+    EXPECT_EQ(GatewayPathUnavailable, responses[1].message<ModbusExceptionMessage>().exception());
+    EXPECT_FALSE(client.is_connected());
+    EXPECT_EQ(1u, client.stats().timeouts);
+    EXPECT_EQ(1u, client.stats().failures);
+}
+
+TEST(ModbusClient, delivers_responses_received_with_the_close) {
+    ModbusLoopbackServer server(64);
+    server.set_hang_up(true);
+    Reactor reactor;
+    ModbusClient client(reactor);
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    client.request(ReadHoldingRegistersRequest(5, 1), boost::bind(record, &responses, _1));
+    // Let the response and the close both arrive before reading either
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+    wait_for(reactor, responses, 1);
+
+    ASSERT_EQ(1u, responses.size());
+    ASSERT_FALSE(responses[0].isException());
+    EXPECT_EQ(5, responses[0].message<ReadHoldingRegistersResponse>().registers[0]);
+    EXPECT_EQ(0u, client.stats().failures);
+}
+
+// Find the client's end of a connection from the server's descriptor
+static int connected_socket(int accepted) {
+    struct sockaddr_in peer, local;
+    socklen_t length = sizeof(peer);
+    getpeername(accepted, (struct sockaddr*)&peer, &length);
+    for (int fd = 0; fd < 1024; fd++) {
+        length = sizeof(local);
+        if (fd == accepted || getsockname(fd, (struct sockaddr*)&local, &length) < 0) continue;
+        if (local.sin_port == peer.sin_port && local.sin_addr.s_addr == peer.sin_addr.s_addr) return fd;
+    }
+    return -1;
+}
+
+TEST(ModbusClient, sends_pending_requests_once_writable) {
+    const size_t REQUESTS = 2000;
+    // A server that reads slowly, with a small receive buffer
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_LE(0, listener);
+    int size = 4096;
+    setsockopt(listener, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(local);
+    ASSERT_EQ(0, ::bind(listener, (struct sockaddr*)&local, sizeof(local)));
+    ASSERT_EQ(0, listen(listener, 1));
+    ASSERT_EQ(0, getsockname(listener, (struct sockaddr*)&local, &length));
+
+    Reactor reactor;
+    ModbusClient client(reactor, 1, REQUESTS);
+    client.connect("127.0.0.1", ntohs(local.sin_port));
+    int accepted = accept(listener, 0, 0);
+    ASSERT_LE(0, accepted);
+    // Keep the kernel from growing the client's send buffer to take every request
+    int fd = connected_socket(accepted);
+    ASSERT_LE(0, fd);
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+    vector<ModbusTcpMessage> responses;
+    vector<uint16_t> registers(MODBUS_MAX_WRITE_REGISTERS, 1);
+    for (size_t i = 0; i < REQUESTS; i++) {
+        client.request(WriteMultipleRegistersRequest(0, registers), boost::bind(record, &responses, _1));
+    }
+    EXPECT_EQ(REQUESTS, client.outstanding());
+
+    // Each request is a 7 byte header, function, address, count, byte count and registers
+    const size_t EXPECTED = REQUESTS * (13 + 2 * MODBUS_MAX_WRITE_REGISTERS);
+    size_t received = 0;
+    uint8_t chunk[4096];
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (received < EXPECTED && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(10)));
+        ssize_t got;
+        while ((got = recv(accepted, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0) received += size_t(got);
+    }
+    client.close();
+    close(accepted);
+    close(listener);
+
+    EXPECT_EQ(EXPECTED, received);
+    EXPECT_EQ(REQUESTS, responses.size());
+}
@@ -0,0 +1,130 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include "Modbus.h"
+#include "ModbusFrame.h"
+#include "ModbusClient.h"
+#include "ModbusLoopbackServer.h"
+
+using namespace std;
+using namespace j2;
+
+static buffer encode_response(uint16_t transactionId, const ModbusResponse& response) {
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    ModbusTcpMessage(transactionId, uint16_t(1), response).serialize(writer);
+    return *encoded;
+}
+
+TEST(ModbusFrame, parses_registers_in_place) {
+    const uint16_t REGISTERS[] = { 0x01, 0x0203, 0xfedc };
+    vector<uint16_t> registers(REGISTERS, REGISTERS + 3);
+    buffer encoded = encode_response(7, ReadHoldingRegistersResponse(registers));
+
+    ModbusFrame frame;
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(encoded)));
+    EXPECT_EQ(7, frame.transactionId);
+    EXPECT_EQ(1, frame.unitId);
+    EXPECT_EQ(ReadHoldingRegisters, frame.functionCode);
+    EXPECT_EQ(encoded.size(), frame.frame_size());
+
+    ReadHoldingRegistersResponseView response;
+    ASSERT_TRUE(response.parse(frame));
+    ASSERT_EQ(3u, response.registers.size());
+    // The view reads the received bytes rather than a copy
+    EXPECT_EQ(&encoded[9], response.registers.bytes().data());
+    EXPECT_EQ(0x01, response.registers[0]);
+    EXPECT_EQ(0x0203, response.registers[1]);
+    EXPECT_EQ(0xfedc, response.registers[2]);
+    vector<uint16_t> copied;
+    response.registers.copy_to(copied);
+    EXPECT_EQ(registers, copied);
+
+    WriteMultipleRegistersResponseView wrong_function;
+    EXPECT_FALSE(wrong_function.parse(frame));
+}
+
+TEST(ModbusFrame, needs_whole_frames) {
+    buffer encoded = encode_response(1, WriteMultipleRegistersResponse(10, 2));
+    ModbusFrame frame;
+    EXPECT_EQ(ModbusFrame::Incomplete, frame.parse(ByteSpan(&encoded[0], 4)));
+    EXPECT_EQ(ModbusFrame::Incomplete, frame.parse(ByteSpan(&encoded[0], encoded.size() - 1)));
+
+    // Two frames back to back parse one at a time
+    buffer both(encoded);
+    both.insert(both.end(), encoded.begin(), encoded.end());
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(both)));
+    WriteMultipleRegistersResponseView response;
+    ASSERT_TRUE(response.parse(frame));
+    EXPECT_EQ(10, response.startingAddress);
+    EXPECT_EQ(2, response.numberOfRegisters);
+    EXPECT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(both).subspan(frame.frame_size())));
+
+    encoded[2] = 1;
+    EXPECT_EQ(ModbusFrame::Invalid, frame.parse(ByteSpan(encoded)));
+}
+
+TEST(ModbusFrame, parses_requests_and_exceptions) {
+    vector<uint16_t> registers(2, 0xabcd);
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    ModbusTcp::write_request(writer, WriteMultipleRegistersRequest(300, registers), 9, 1);
+
+    ModbusFrame frame;
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(*encoded)));
+    WriteMultipleRegistersRequestView request;
+    ASSERT_TRUE(request.parse(frame));
+    EXPECT_EQ(300, request.starting_address);
+    ASSERT_EQ(2u, request.registers.size());
+    EXPECT_EQ(0xabcd, request.registers[1]);
+
+    const uint8_t EXCEPTION[] = { 0, 9, 0, 0, 0, 3, 1, 0x83, IllegalDataAddress };
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(EXCEPTION, sizeof(EXCEPTION))));
+    EXPECT_TRUE(frame.isException());
+    EXPECT_EQ(IllegalDataAddress, frame.exception());
+}
+
+struct FrameSummary {
+    FrameSummary() : transactionId(0), exception(0), first(0), count(0) { }
+    uint16_t transactionId;
+    uint8_t exception;
+    uint16_t first;
+    size_t count;
+};
+
+// Frames are only valid during the handler, so keep what is needed
+static void summarise(vector<FrameSummary>* summaries, const ModbusFrame& frame) {
+    FrameSummary summary;
+    summary.transactionId = frame.transactionId;
+    summary.exception = frame.isException() ? frame.exception() : 0;
+    ReadHoldingRegistersResponseView response;
+    if (response.parse(frame)) {
+        summary.first = response.registers[0];
+        summary.count = response.registers.size();
+    }
+    summaries->push_back(summary);
+}
+
+TEST(ModbusFrame, client_delivers_frames_in_place) {
+    ModbusLoopbackServer server(64);
+    Reactor reactor;
+    ModbusClient client(reactor, 1, 4, boost::chrono::milliseconds(100));
+    client.connect("127.0.0.1", server.port());
+
+    vector<FrameSummary> summaries;
+    uint16_t id = client.request_frame(ReadHoldingRegistersRequest(20, 8), boost::bind(summarise, &summaries, _1));
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (summaries.empty() && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(50)));
+    }
+    ASSERT_EQ(1u, summaries.size());
+    EXPECT_EQ(id, summaries[0].transactionId);
+    EXPECT_EQ(20, summaries[0].first);
+    EXPECT_EQ(8u, summaries[0].count);
+
+    server.set_silent(true);
+    client.request_frame(ReadHoldingRegistersRequest(0, 1), boost::bind(summarise, &summaries, _1));
+    EXPECT_EQ(1u, client.expire(EventClock::now() + boost::chrono::milliseconds(100)));
+    ASSERT_EQ(2u, summaries.size());
+    EXPECT_EQ(GatewayTargetFailedToRespond, summaries[1].exception);
+}
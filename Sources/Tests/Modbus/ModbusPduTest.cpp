@@ -0,0 +1,101 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "Modbus.h"
+#include "ModbusPdu.h"
+
+using namespace std;
+using namespace j2;
+
+static buffer encode_request(uint16_t transactionId, const ModbusRequest& request) {
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    ModbusTcp::write_request(writer, request, transactionId, 1);
+    return *encoded;
+}
+
+static buffer encode_response(uint16_t transactionId, const ModbusResponse& response) {
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    ModbusTcpMessage(transactionId, uint16_t(1), response).serialize(writer);
+    return *encoded;
+}
+
+static buffer encode_pdu(const ModbusPdu& pdu, uint16_t transactionId) {
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    pdu.write(writer, transactionId, 1);
+    return *encoded;
+}
+
+TEST(ModbusPdu, decodes_and_encodes_requests) {
+    ModbusPdu pdu;
+    ModbusFrame frame;
+    buffer read = encode_request(3, ReadHoldingRegistersRequest(40, 12));
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(read)));
+    ASSERT_TRUE(pdu.decode_request(frame));
+    EXPECT_EQ(ModbusPdu::ReadHoldingRegistersRequestPdu, pdu.kind());
+    EXPECT_EQ(40, pdu.read_request().startingAddress);
+    EXPECT_EQ(12, pdu.read_request().numberOfRegisters);
+    EXPECT_EQ(read, encode_pdu(pdu, 3));
+
+    // The same PDU is reused for the next frame
+    const uint16_t REGISTERS[] = { 0x1234, 0, 0xffff };
+    buffer write = encode_request(4, WriteMultipleRegistersRequest(7, vector<uint16_t>(REGISTERS, REGISTERS + 3)));
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(write)));
+    ASSERT_TRUE(pdu.decode_request(frame));
+    ASSERT_EQ(ModbusPdu::WriteMultipleRegistersRequestPdu, pdu.kind());
+    EXPECT_EQ(7, pdu.write_request().startingAddress);
+    ASSERT_EQ(3, pdu.write_request().numberOfRegisters);
+    EXPECT_EQ(0xffff, pdu.write_request().registers[2]);
+    EXPECT_EQ(write, encode_pdu(pdu, 4));
+
+    // Responses are not requests
+    buffer response = encode_response(5, WriteMultipleRegistersResponse(7, 3));
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(response)));
+    EXPECT_FALSE(pdu.decode_request(frame));
+    EXPECT_EQ(ModbusPdu::Empty, pdu.kind());
+}
+
+TEST(ModbusPdu, decodes_and_encodes_responses) {
+    ModbusPdu pdu;
+    ModbusFrame frame;
+    vector<uint16_t> registers;
+    for (uint16_t i = 0; i < MODBUS_MAX_READ_REGISTERS; i++) registers.push_back(uint16_t(i * 3));
+    buffer read = encode_response(8, ReadHoldingRegistersResponse(registers));
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(read)));
+    ASSERT_TRUE(pdu.decode_response(frame));
+    ASSERT_EQ(ModbusPdu::ReadHoldingRegistersResponsePdu, pdu.kind());
+    ASSERT_EQ(MODBUS_MAX_READ_REGISTERS, pdu.read_response().numberOfRegisters);
+    EXPECT_EQ(372, pdu.read_response().registers[124]);
+    EXPECT_EQ(read, encode_pdu(pdu, 8));
+
+    buffer written = encode_response(9, WriteMultipleRegistersResponse(100, 2));
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(written)));
+    ASSERT_TRUE(pdu.decode_response(frame));
+    EXPECT_EQ(100, pdu.write_response().startingAddress);
+    EXPECT_EQ(2, pdu.write_response().numberOfRegisters);
+    EXPECT_EQ(written, encode_pdu(pdu, 9));
+
+    const uint8_t EXCEPTION[] = { 0, 9, 0, 0, 0, 3, 1, 0x90, IllegalDataAddress };
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(EXCEPTION, sizeof(EXCEPTION))));
+    ASSERT_TRUE(pdu.decode_response(frame));
+    ASSERT_EQ(ModbusPdu::ExceptionPdu, pdu.kind());
+    EXPECT_EQ(0x90, pdu.functionCode());
+    EXPECT_EQ(IllegalDataAddress, pdu.exception().exception);
+    EXPECT_EQ(buffer(EXCEPTION, EXCEPTION + sizeof(EXCEPTION)), encode_pdu(pdu, 9));
+}
+
+TEST(ModbusPdu, rejects_malformed_messages) {
+    ModbusPdu pdu;
+    ModbusFrame frame;
+    // Frames too large for the inline registers are not frames at all
+    buffer write = encode_request(1, WriteMultipleRegistersRequest(0, vector<uint16_t>(MODBUS_MAX_WRITE_REGISTERS + 1)));
+    EXPECT_EQ(ModbusFrame::Invalid, frame.parse(ByteSpan(write)));
+
+    // A byte count that disagrees with the frame size
+    buffer read = encode_response(2, ReadHoldingRegistersResponse(vector<uint16_t>(4)));
+    read[8] = 10;
+    ASSERT_EQ(ModbusFrame::Complete, frame.parse(ByteSpan(read)));
+    EXPECT_FALSE(pdu.decode_response(frame));
+    EXPECT_EQ(InvalidFunction, pdu.functionCode());
+}
@@ -0,0 +1,182 @@
+#include <vector>
+#include <cerrno>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include "ModbusClient.h"
+#include "ModbusServer.h"
+
+using namespace std;
+using namespace j2;
+
+static void collect(vector<ModbusTcpMessage>* responses, const ModbusTcpMessage& response) {
+    responses->push_back(response);
+}
+
+// Run the reactor serving both ends until the expected responses arrive
+static void run_until(Reactor& reactor, const vector<ModbusTcpMessage>& responses, size_t count) {
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (responses.size() < count && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(50)));
+    }
+}
+
+TEST(ModbusServer, serves_register_image) {
+    ModbusRegisterImage image(100);
+    image.set(10, 12.5f);
+    image.set(12, int32_t(-70000));
+    Reactor reactor;
+    ModbusServer server(reactor, image);
+    server.listen("127.0.0.1", 0);
+    ModbusClient client(reactor);
+    client.connect("127.0.0.1", server.port());
+
+    vector<ModbusTcpMessage> responses;
+    client.request(ReadHoldingRegistersRequest(10, 4), boost::bind(collect, &responses, _1));
+    client.request(WriteMultipleRegistersRequest(50, vector<uint16_t>(2, 7)),
+                   boost::bind(collect, &responses, _1));
+    client.request(ReadHoldingRegistersRequest(99, 2), boost::bind(collect, &responses, _1));
+    run_until(reactor, responses, 3);
+
+    ASSERT_EQ(3u, responses.size());
+    const vector<uint16_t>& registers = responses[0].message<ReadHoldingRegistersResponse>().registers;
+    ASSERT_EQ(4u, registers.size());
+    EXPECT_EQ(12.5f, RegisterCodec<float>::decode(&registers[0]));
+    EXPECT_EQ(-70000, RegisterCodec<int32_t>::decode(&registers[2]));
+    EXPECT_EQ(2, responses[1].message<WriteMultipleRegistersResponse>().numberOfRegisters);
+    EXPECT_EQ(7, image.get<uint16_t>(51));
+    ASSERT_TRUE(responses[2].isException());
+    EXPECT_EQ(IllegalDataAddress, responses[2].message<ModbusExceptionMessage>().exception());
+    EXPECT_EQ(3u, server.stats().requests);
+    EXPECT_EQ(1u, server.stats().exceptions);
+}
+
+TEST(ModbusServer, serves_hundreds_of_clients_on_one_thread) {
+    const size_t CLIENTS = 200;
+    ModbusRegisterImage image;
+    image.set(0, uint16_t(42));
+    Reactor reactor;
+    ModbusServer server(reactor, image, CLIENTS);
+    server.listen("127.0.0.1", 0);
+
+    vector<ModbusTcpMessage> responses;
+    vector<std::tr1::shared_ptr<ModbusClient> > clients;
+    for (size_t i = 0; i < CLIENTS + 1; i++) {
+        clients.push_back(std::tr1::shared_ptr<ModbusClient>(new ModbusClient(reactor)));
+        clients.back()->connect("127.0.0.1", server.port());
+        clients.back()->request(ReadHoldingRegistersRequest(0, 1), boost::bind(collect, &responses, _1));
+    }
+    run_until(reactor, responses, CLIENTS + 1);
+
+    // The client over the limit is disconnected
+    ASSERT_EQ(CLIENTS + 1, responses.size());
+    size_t answered = 0;
+    for (size_t i = 0; i < responses.size(); i++) {
+        if (responses[i].isException()) {
+            EXPECT_EQ(GatewayPathUnavailable, responses[i].message<ModbusExceptionMessage>().exception());
+            continue;
+        }
+        EXPECT_EQ(42, responses[i].message<ReadHoldingRegistersResponse>().registers[0]);
+        answered++;
+    }
+    EXPECT_EQ(CLIENTS, answered);
+    EXPECT_EQ(CLIENTS, server.connections());
+    EXPECT_EQ(1u, server.stats().rejected);
+}
+
+// Find the server's end of the connection from the client's descriptor
+static int accepted_socket(int client) {
+    struct sockaddr_in local, peer;
+    socklen_t length = sizeof(local);
+    getsockname(client, (struct sockaddr*)&local, &length);
+    for (int fd = 0; fd < 1024; fd++) {
+        length = sizeof(peer);
+        if (fd == client || getpeername(fd, (struct sockaddr*)&peer, &length) < 0) continue;
+        if (peer.sin_port == local.sin_port && peer.sin_addr.s_addr == local.sin_addr.s_addr) return fd;
+    }
+    return -1;
+}
+
+TEST(ModbusServer, sends_pending_responses_once_writable) {
+    const size_t REQUESTS = 230;
+    ModbusRegisterImage image;
+    Reactor reactor;
+    ModbusServer server(reactor, image);
+    server.listen("127.0.0.1", 0);
+
+    // A client which pipelines requests whose responses overflow the
+    // socket buffers, and then sends nothing more
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_LE(0, fd);
+    int size = 4096;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    struct sockaddr_in remote;
+    memset(&remote, 0, sizeof(remote));
+    remote.sin_family = AF_INET;
+    remote.sin_port = htons(server.port());
+    remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(0, connect(fd, (struct sockaddr*)&remote, sizeof(remote)));
+    reactor.wait(EventClock::duration(boost::chrono::milliseconds(100)));
+    ASSERT_EQ(1u, server.connections());
+    // Keep the kernel from growing the server's send buffer to take every response
+    int accepted = accepted_socket(fd);
+    ASSERT_LE(0, accepted);
+    setsockopt(accepted, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    shared_buffer requests(new buffer);
+    MemoryIoWriter writer(requests);
+    for (size_t i = 0; i < REQUESTS; i++) {
+        ReadHoldingRegistersRequest request(0, MODBUS_MAX_READ_REGISTERS);
+        ModbusTcp::write_request(writer, request, uint16_t(i), 1);
+    }
+    ASSERT_EQ(ssize_t(requests->size()), send(fd, &(*requests)[0], requests->size(), MSG_NOSIGNAL));
+
+    // Each response is a 7 byte header, function, byte count and registers
+    const size_t EXPECTED = REQUESTS * (9 + 2 * MODBUS_MAX_READ_REGISTERS);
+    size_t received = 0;
+    uint8_t chunk[4096];
+    EventClock::time_point give_up = EventClock::now() + boost::chrono::seconds(5);
+    while (received < EXPECTED && EventClock::now() < give_up) {
+        reactor.wait(EventClock::duration(boost::chrono::milliseconds(10)));
+        ssize_t got = recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (got > 0) received += size_t(got);
+    }
+    close(fd);
+
+    EXPECT_EQ(EXPECTED, received);
+    EXPECT_EQ(REQUESTS, server.stats().requests);
+}
+
+TEST(ModbusServer, rejects_unsupported_functions) {
+    ModbusRegisterImage image(10);
+    // Read exception status, which has no request data
+    const uint8_t REQUEST[] = { 0x00, 0x05, 0x00, 0x00, 0x00, 0x02, 0x01, ReadExceptionStatus };
+    ModbusFrame request;
+    ASSERT_EQ(ModbusFrame::Complete, request.parse(ByteSpan(REQUEST, sizeof(REQUEST))));
+    shared_buffer encoded(new buffer);
+    MemoryIoWriter writer(encoded);
+    EXPECT_TRUE(ModbusServer::respond(image, request, writer));
+
+    MemoryIoReader response_reader(encoded);
+    ModbusTcpMessage response = ModbusTcp::read_response(response_reader);
+    EXPECT_FALSE(response_reader.hasError());
+    EXPECT_EQ(5, response.transactionId);
+    EXPECT_EQ(ReadExceptionStatus | MODBUS_EXCEPTION_FLAG, response.functionCode);
+    EXPECT_EQ(IllegalFunction, response.message<ModbusExceptionMessage>().exception());
+}
+
+TEST(ModbusServer, updates_register_image_from_topics) {
+    EventRouter* router = new EventRouter();
+    RegisterImageModule module(router);
+    module.map<double>("/payload/weight", 100);
+    module.map< Timestamped<int32_t> >("/payload/count", 102);
+    router->publish("/payload/weight", 81.25);
+    router->publish("/payload/count", Timestamped<int32_t>(3));
+    module.process_all();
+
+    EXPECT_EQ(81.25, module.image().get<double>(100));
+    EXPECT_EQ(3, module.image().get<int32_t>(102));
+    EXPECT_FALSE(module.image().set(MODBUS_REGISTERS - 1, 1.0));
+}
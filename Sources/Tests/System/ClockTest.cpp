@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <Clock.h>
+#include <Timestamp.h>
+
+using namespace j2;
+using boost::chrono::milliseconds;
+using boost::chrono::hours;
+
+TEST(Clock, follows_steady_clock_by_default) {
+    EXPECT_EQ((const ClockSource*)0, Clock::source());
+    Clock::time_point before = boost::chrono::steady_clock::now();
+    Clock::time_point now = Clock::now();
+    EXPECT_LE(before, now);
+    EXPECT_LE(now, boost::chrono::steady_clock::now());
+}
+
+TEST(Clock, can_simulate_time) {
+    Clock::time_point start = Clock::now() + hours(1);
+    SimulatedClock simulated(start);
+    {
+        ScopedClockSource use(simulated);
+        EXPECT_EQ(start, Clock::now());
+        simulated.advance(milliseconds(50));
+        EXPECT_EQ(start + milliseconds(50), Clock::now());
+        simulated.set(start);
+        EXPECT_EQ(start + milliseconds(50), Clock::now());
+        simulated.set(start + hours(12));
+
+        Timestamped<int> value(1);
+        EXPECT_EQ(start + hours(12), value.timestamp());
+    }
+    EXPECT_EQ((const ClockSource*)0, Clock::source());
+    EXPECT_LT(Clock::now(), start);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <DeadlineScheduler.h>
+
+using namespace j2;
+using namespace std;
+using namespace std::tr1;
+
+class PeriodicModule : public Module {
+public:
+    PeriodicModule(std::tr1::shared_ptr<EventRouter> router) :
+        Module(router),
+        value(0),
+        updates(0),
+        updated_value(0) {
+        bind_value("value", &value);
+    }
+
+    virtual void update() {
+        updates++;
+        updated_value = value;
+    }
+
+    int value;
+    int updates;
+    int updated_value;
+};
+
+class BackgroundModule : public Module {
+public:
+    BackgroundModule(std::tr1::shared_ptr<EventRouter> router) :
+        Module(router),
+        text("") {
+        bind_value("text", &text);
+    }
+
+    std::string text;
+};
+
+static void sleep_ms(int ms) {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(ms));
+}
+
+TEST(DeadlineScheduler, runs_released_modules_before_events) {
+    EventRouter* router = new EventRouter;
+    DeadlineScheduler scheduler;
+    Supervisor supervisor(&scheduler, router);
+    boost::shared_ptr<BackgroundModule> background = supervisor.load<BackgroundModule>();
+    boost::shared_ptr<PeriodicModule> periodic = supervisor.load<PeriodicModule>();
+    scheduler.set_period(periodic, boost::chrono::milliseconds(20));
+
+    router->publish("text", std::string("hello"));
+    router->publish("value", 5);
+    EXPECT_EQ(periodic.get(), supervisor.schedule().get());
+    EXPECT_EQ(1, periodic->updates);
+    EXPECT_EQ(5, periodic->updated_value);
+
+    // Not released again until the period has passed
+    EXPECT_EQ(background.get(), supervisor.schedule().get());
+    EXPECT_EQ("hello", background->text);
+    EXPECT_FALSE(supervisor.schedule());
+    EXPECT_TRUE(scheduler.next_release());
+
+    sleep_ms(25);
+    EXPECT_EQ(periodic.get(), supervisor.schedule().get());
+    EXPECT_EQ(2, periodic->updates);
+    EXPECT_EQ(2u, scheduler.deadline_stats(periodic.get()).runs);
+}
+
+TEST(DeadlineScheduler, orders_by_deadline_or_rate) {
+    EventRouter* router = new EventRouter;
+    DeadlineScheduler edf(DeadlineScheduler::EarliestDeadlineFirst);
+    DeadlineScheduler rm(DeadlineScheduler::RateMonotonic);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<PeriodicModule> fast = supervisor.load<PeriodicModule>();
+    boost::shared_ptr<PeriodicModule> urgent = supervisor.load<PeriodicModule>();
+    ModuleList modules;
+
+    edf.set_period(fast, boost::chrono::milliseconds(100));
+    edf.set_period(urgent, boost::chrono::milliseconds(500), boost::chrono::milliseconds(1));
+    rm.set_period(fast, boost::chrono::milliseconds(100));
+    rm.set_period(urgent, boost::chrono::milliseconds(500), boost::chrono::milliseconds(1));
+    sleep_ms(5);
+
+    EXPECT_EQ(urgent.get(), edf.schedule(modules).get());
+    EXPECT_EQ(fast.get(), rm.schedule(modules).get());
+
+    // Released 5ms ago with a 1ms deadline
+    DeadlineStats stats = edf.deadline_stats(urgent.get());
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_GE(stats.max_lateness, boost::chrono::milliseconds(4));
+    EXPECT_EQ(0u, edf.deadline_stats(fast.get()).misses);
+}
+
+TEST(DeadlineScheduler, rejects_non_positive_periods) {
+    EventRouter* router = new EventRouter;
+    DeadlineScheduler scheduler;
+    Supervisor supervisor(&scheduler, router);
+    boost::shared_ptr<PeriodicModule> periodic = supervisor.load<PeriodicModule>();
+
+    EXPECT_THROW(scheduler.set_period(periodic, EventClock::duration::zero()), std::invalid_argument);
+    EXPECT_THROW(scheduler.set_period(periodic, boost::chrono::milliseconds(-1)), std::invalid_argument);
+    EXPECT_FALSE(scheduler.next_release());
+}
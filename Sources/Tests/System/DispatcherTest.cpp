@@ -0,0 +1,119 @@
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <gtest/gtest.h>
+#include <Dispatcher.h>
+
+using namespace j2;
+using namespace std;
+
+typedef Dispatcher<void (int)> IntDispatcher;
+typedef std::tr1::shared_ptr<IntDispatcher> IntDispatcherPtr;
+
+static void record(vector<int>* values, int value) {
+    values->push_back(value);
+}
+
+static void add(int* total, int value) {
+    *total += value;
+}
+
+// Functor too large to be stored inline in a Delegate
+struct LargeFunctor {
+    LargeFunctor(int* total) : total(total) { }
+    void operator()(int value) const { *total += value + padding[0]; }
+    int* total;
+    char padding[DELEGATE_INLINE_SIZE * 2];
+};
+
+TEST(Dispatcher, delivers_in_connection_order) {
+    IntDispatcherPtr dispatcher(new IntDispatcher);
+    vector<int> first;
+    vector<int> second;
+    dispatcher->connect(boost::bind(record, &first, _1));
+    dispatcher->connect(boost::bind(record, &second, _1));
+    EXPECT_EQ(2, dispatcher->size());
+    (*dispatcher)(1);
+    (*dispatcher)(2);
+    ASSERT_EQ(2, first.size());
+    ASSERT_EQ(2, second.size());
+    EXPECT_EQ(1, first[0]);
+    EXPECT_EQ(2, second[1]);
+}
+
+TEST(Dispatcher, can_store_large_targets) {
+    IntDispatcherPtr dispatcher(new IntDispatcher);
+    int total = 0;
+    LargeFunctor large(&total);
+    large.padding[0] = 1;
+    dispatcher->connect(large);
+    (*dispatcher)(1);
+    (*dispatcher)(2);
+    EXPECT_EQ(5, total);
+}
+
+TEST(Dispatcher, can_block_unblock_and_disconnect) {
+    IntDispatcherPtr dispatcher(new IntDispatcher);
+    int total = 0;
+    Connection connection = dispatcher->connect(boost::bind(add, &total, _1));
+    EXPECT_TRUE(connection.connected());
+    connection.block();
+    (*dispatcher)(1);
+    EXPECT_EQ(0, total);
+    connection.unblock();
+    (*dispatcher)(2);
+    EXPECT_EQ(2, total);
+    connection.disconnect();
+    EXPECT_FALSE(connection.connected());
+    EXPECT_TRUE(dispatcher->empty());
+    (*dispatcher)(4);
+    EXPECT_EQ(2, total);
+}
+
+TEST(Dispatcher, connection_outlives_dispatcher) {
+    Connection connection;
+    {
+        IntDispatcherPtr dispatcher(new IntDispatcher);
+        int total = 0;
+        connection = dispatcher->connect(boost::bind(add, &total, _1));
+    }
+    EXPECT_FALSE(connection.connected());
+    connection.block();
+    connection.disconnect();
+}
+
+// Delegate that modifies the dispatcher invoking it
+struct Reconnector {
+    Reconnector(IntDispatcher* dispatcher, Connection* self, int* total) :
+        dispatcher(dispatcher), self(self), total(total) { }
+
+    void operator()(int) const {
+        self->disconnect();
+        dispatcher->connect(boost::bind(add, total, _1));
+    }
+
+    IntDispatcher* dispatcher;
+    Connection* self;
+    int* total;
+};
+
+TEST(Dispatcher, can_change_connections_during_emit) {
+    IntDispatcherPtr dispatcher(new IntDispatcher);
+    int total = 0;
+    Connection self;
+    Connection later;
+    self = dispatcher->connect(Reconnector(dispatcher.get(), &self, &total));
+    dispatcher->connect(boost::bind(&Connection::disconnect, &later));
+    later = dispatcher->connect(boost::bind(add, &total, _1));
+
+    // Disconnecting a later slot during emit stops delivery to it, and the
+    // delegate connected during emit is not called until the next emit
+    (*dispatcher)(1);
+    EXPECT_FALSE(self.connected());
+    EXPECT_FALSE(later.connected());
+    EXPECT_EQ(0, total);
+
+    (*dispatcher)(10);
+    EXPECT_EQ(10, total);
+    EXPECT_EQ(2, dispatcher->size());
+}
@@ -1,5 +1,9 @@
 #include <iostream>
+#include <sstream>
 #include <tr1/functional>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 #include <gtest/gtest.h>
 #include <EventRouter.h>
 
@@ -101,3 +105,594 @@ TEST(EventRouter, can_use_queueing_delivery_policy) {
     EXPECT_EQ(EXPECTED_INT, *shared_ptr_int);
 }
 
+TEST(EventRouter, interns_topics) {
+    EventRouter router;
+    TopicId pitch = router.topic("/sensor/inclinometer/pitch");
+    TopicId hoist = router.topic("/motion/hoist");
+    EXPECT_NE(pitch, hoist);
+    EXPECT_EQ(pitch, router.topic("/sensor/inclinometer/pitch"));
+    EXPECT_EQ("/motion/hoist", router.topic_name(hoist));
+    EXPECT_EQ(2, router.topic_count());
+
+    // Subscribing by name resolves to the same topic
+    EXPECT_EQ(hoist, router.subscribe<int>("/motion/hoist").topic());
+    EXPECT_EQ(2, router.topic_count());
+}
+
+TEST(EventRouter, can_pub_and_sub_with_topic_ids) {
+    EventRouter router;
+    int EXPECTED_INT = 99;
+    int by_id = 0;
+    int by_name = 0;
+    TopicId topic = router.topic("int");
+    router.subscribe<int>(topic).assign_to(&by_id);
+    router.subscribe<int>("int")
+        .deliver_with(receive_int)
+        .assign_to(&by_name);
+    router.publish(topic, EXPECTED_INT);
+    EXPECT_EQ(EXPECTED_INT, by_id);
+    EXPECT_EQ(EXPECTED_INT, by_name);
+}
+
+TEST(EventRouter, can_route_between_topic_ids) {
+    EventRouter receiver_router;
+    EventRouter publisher_router;
+    int EXPECTED_INT = 99;
+    int byref = 0;
+    // Topic ids are per router so the same name may map to different ids
+    receiver_router.topic("padding");
+    TopicId dest = receiver_router.topic("int");
+    TopicId source = publisher_router.topic("int");
+    receiver_router.subscribe<int>(dest).assign_to(&byref);
+    publisher_router.route(source, receiver_router, dest);
+    publisher_router.publish(source, EXPECTED_INT);
+    EXPECT_EQ(EXPECTED_INT, byref);
+}
+
+TEST(EventRouter, queued_events_keep_topic) {
+    EventQueue* queue = new EventQueue;
+    QueueingDeliveryPolicy policy(queue);
+    EventRouter router(policy);
+    int EXPECTED_INT = 99;
+    int byref = 0;
+    TopicId topic = router.topic("int");
+    router.subscribe<int>(topic).assign_to(&byref);
+    router.publish(topic, EXPECTED_INT);
+    EXPECT_EQ(0, byref);
+    EXPECT_TRUE(queue->deliver());
+    EXPECT_EQ(EXPECTED_INT, byref);
+}
+
+struct Sample {
+    Sample() : position(0), velocity(0) { }
+    Sample(double position, double velocity) : position(position), velocity(velocity) { }
+    double position;
+    double velocity;
+};
+
+static void receive_sample(std::vector<double>* positions, const Sample& sample) {
+    positions->push_back(sample.position);
+}
+
+static void receive_any(std::vector<std::string>* names,
+                        const std::string& name,
+                        const boost::any&) {
+    names->push_back(name);
+}
+
+TEST(EventRouter, can_pub_and_sub_with_channel) {
+    EventRouter router;
+    Channel<Sample> hoist = router.channel<Sample>("/motion/hoist");
+    EXPECT_EQ("/motion/hoist", hoist.name());
+    EXPECT_EQ(router.topic("/motion/hoist"), hoist.topic());
+
+    Sample byref;
+    std::vector<double> positions;
+    hoist.assign_to(&byref);
+    hoist.deliver_with(boost::bind(receive_sample, &positions, _1));
+
+    hoist.publish(Sample(1.5, 2.0));
+    EXPECT_EQ(1.5, byref.position);
+    EXPECT_EQ(2.0, byref.velocity);
+    ASSERT_EQ(1, positions.size());
+
+    // Channels for the same topic share subscribers
+    router.channel<Sample>("/motion/hoist").publish(Sample(3.0, 0.0));
+    EXPECT_EQ(3.0, byref.position);
+    EXPECT_EQ(2, positions.size());
+}
+
+TEST(EventRouter, channels_work_alongside_untyped_subscribers) {
+    EventRouter router;
+    Channel<Sample> hoist = router.channel<Sample>("/motion/hoist");
+    Sample typed;
+    Sample untyped;
+    std::vector<std::string> names;
+    hoist.assign_to(&typed);
+    router.subscribe<Sample>("/motion/hoist").assign_to(&untyped);
+    router.subscribe("/motion/hoist", boost::bind(receive_any, &names, _1, _2));
+
+    // Typed publish reaches untyped subscribers
+    hoist.publish(Sample(1.0, 0.0));
+    EXPECT_EQ(1.0, typed.position);
+    EXPECT_EQ(1.0, untyped.position);
+    ASSERT_EQ(1, names.size());
+    EXPECT_EQ("/motion/hoist", names[0]);
+
+    // Untyped publish reaches typed subscribers
+    router.publish("/motion/hoist", Sample(2.0, 0.0));
+    EXPECT_EQ(2.0, typed.position);
+    EXPECT_EQ(2.0, untyped.position);
+    EXPECT_EQ(2, names.size());
+}
+
+TEST(EventRouter, channels_respect_queueing_delivery_policy) {
+    EventQueue* queue = new EventQueue;
+    QueueingDeliveryPolicy policy(queue);
+    EventRouter router(policy);
+    Channel<Sample> hoist = router.channel<Sample>("/motion/hoist");
+    Sample byref;
+    hoist.assign_to(&byref);
+    hoist.publish(Sample(1.0, 0.0));
+    EXPECT_EQ(0.0, byref.position);
+    EXPECT_EQ(1, queue->size());
+    while (queue->deliver());
+    EXPECT_EQ(1.0, byref.position);
+}
+
+TEST(EventRouter, channel_type_must_match) {
+    EventRouter router;
+    router.channel<Sample>("/motion/hoist");
+    EXPECT_THROW(router.channel<int>("/motion/hoist"), std::invalid_argument);
+}
+
+TEST(EventRouter, can_block_and_unsubscribe) {
+    EventRouter router;
+    int byref = 0;
+    Subscription<int> subscription = router.subscribe<int>("int").assign_to(&byref);
+    subscription.block();
+    router.publish("int", 1);
+    EXPECT_EQ(0, byref);
+    subscription.unblock();
+    router.publish("int", 2);
+    EXPECT_EQ(2, byref);
+    subscription.unsubscribe();
+    router.publish("int", 3);
+    EXPECT_EQ(2, byref);
+    EXPECT_TRUE(router.signal_for("int")->empty());
+}
+
+
+static void append_int(vector<int>* values, int value) {
+    values->push_back(value);
+}
+
+TEST(EventRouter, conflating_queue_keeps_latest_value) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    QueueingDeliveryPolicy policy(queue);
+    EventRouter router(policy);
+    vector<int> hoist;
+    vector<int> drag;
+    router.subscribe<int>("/motion/hoist").deliver_with2(boost::bind(append_int, &hoist, _1));
+    router.subscribe<int>("/motion/drag").deliver_with2(boost::bind(append_int, &drag, _1));
+    queue->set_mode(router.topic("/motion/hoist"), Conflate);
+    EXPECT_EQ(Conflate, queue->mode(router.topic("/motion/hoist")));
+    EXPECT_EQ(QueueAll, queue->mode(router.topic("/motion/drag")));
+
+    for (int i = 1; i <= 3; i++) {
+        router.publish("/motion/hoist", i);
+        router.publish("/motion/drag", i);
+    }
+    EXPECT_EQ(4, queue->size());
+    while (queue->deliver());
+    ASSERT_EQ(1, hoist.size());
+    EXPECT_EQ(3, hoist[0]);
+    EXPECT_EQ(3, drag.size());
+
+    // Conflation applies again once the pending value has been delivered
+    queue->set_default_mode(Conflate);
+    router.publish("/motion/hoist", 4);
+    router.publish("/motion/drag", 4);
+    router.publish("/motion/drag", 5);
+    EXPECT_EQ(2, queue->size());
+    while (queue->deliver());
+    ASSERT_EQ(2, hoist.size());
+    EXPECT_EQ(4, hoist[1]);
+    ASSERT_EQ(4, drag.size());
+    EXPECT_EQ(5, drag[3]);
+}
+
+// Value too large to be stored inline in an EventPayload
+struct LargeSample {
+    LargeSample(int value = 0) : value(value) { }
+    int value;
+    char padding[EVENT_INLINE_SIZE * 2];
+};
+
+static void append_large(vector<int>* values, const LargeSample& sample) {
+    values->push_back(sample.value);
+}
+
+TEST(EventRouter, event_queue_grows_in_order) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue(QueueAll, 3));
+    QueueingDeliveryPolicy policy(queue);
+    EventRouter router(policy);
+    EXPECT_EQ(4, queue->capacity());
+    vector<int> received;
+    router.subscribe<int>("int").deliver_with2(boost::bind(append_int, &received, _1));
+
+    // Wrap around the ring before it has to grow
+    router.publish("int", 0);
+    router.publish("int", 1);
+    queue->deliver();
+    queue->deliver();
+    for (int i = 2; i < 12; i++) router.publish("int", i);
+    EXPECT_EQ(16, queue->capacity());
+    EXPECT_EQ(10, queue->high_water_mark());
+    while (queue->deliver());
+    ASSERT_EQ(12, received.size());
+    for (int i = 0; i < 12; i++) EXPECT_EQ(i, received[i]);
+}
+
+TEST(EventRouter, event_queue_delivers_typed_values) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    QueueingDeliveryPolicy policy(queue);
+    EventRouter router(policy);
+    TopicId hoist = router.topic("/motion/hoist");
+    TopicId large = router.topic("/large");
+    Sample byref;
+    Sample untyped;
+    vector<int> received;
+    router.channel<Sample>(hoist).assign_to(&byref);
+    router.channel<LargeSample>(large).deliver_with(boost::bind(append_large, &received, _1));
+
+    queue->enqueue_value(router, hoist, Sample(1.0, 2.0));
+    queue->enqueue_value(router, large, LargeSample(3));
+    while (queue->deliver());
+    EXPECT_EQ(1.0, byref.position);
+    EXPECT_EQ(2.0, byref.velocity);
+    ASSERT_EQ(1, received.size());
+    EXPECT_EQ(3, received[0]);
+
+    // Untyped subscribers receive the value boxed
+    router.subscribe<Sample>(hoist).assign_to(&untyped);
+    queue->enqueue_value(router, hoist, Sample(3.0, 4.0));
+    while (queue->deliver());
+    EXPECT_EQ(3.0, byref.position);
+    EXPECT_EQ(3.0, untyped.position);
+}
+
+// Publish 0..count-1 on "int" then deliver everything queued
+static vector<int> overflow_queue(OverflowPolicy policy, int count, QueueStats* stats) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    queue->set_capacity(4, policy);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    vector<int> received;
+    router.subscribe<int>("int").deliver_with2(boost::bind(append_int, &received, _1));
+    router.subscribe<int>("other").deliver_with2(boost::bind(append_int, &received, _1));
+    for (int i = 0; i < count; i++) router.publish(i % 3 == 2 ? "other" : "int", i);
+    *stats = queue->stats();
+    while (queue->deliver());
+    return received;
+}
+
+TEST(EventRouter, event_queue_can_drop_on_overflow) {
+    QueueStats stats;
+    vector<int> oldest = overflow_queue(DropOldest, 10, &stats);
+    EXPECT_EQ(4, stats.size);
+    EXPECT_EQ(6, stats.dropped);
+    ASSERT_EQ(4, oldest.size());
+    EXPECT_EQ(6, oldest[0]);
+    EXPECT_EQ(9, oldest[3]);
+
+    vector<int> newest = overflow_queue(DropNewest, 10, &stats);
+    EXPECT_EQ(6, stats.dropped);
+    ASSERT_EQ(4, newest.size());
+    EXPECT_EQ(0, newest[0]);
+    EXPECT_EQ(3, newest[3]);
+}
+
+TEST(EventRouter, event_queue_can_spill_to_conflate) {
+    QueueStats stats;
+    vector<int> received = overflow_queue(SpillToConflate, 10, &stats);
+    EXPECT_EQ(6, stats.size);
+    EXPECT_EQ(6, stats.spilled);
+    EXPECT_EQ(4, stats.high_water_mark);
+    // The first four events, then the latest value of each overflowing
+    // topic in order of first overflow
+    ASSERT_EQ(6, received.size());
+    EXPECT_EQ(3, received[3]);
+    EXPECT_EQ(9, received[4]);
+    EXPECT_EQ(8, received[5]);
+}
+
+TEST(EventRouter, event_queue_keeps_spilled_topics_in_order) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    queue->set_capacity(2, SpillToConflate);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    vector<int> received;
+    router.subscribe<int>("int").deliver_with2(boost::bind(append_int, &received, _1));
+    router.publish("int", 0);
+    router.publish("int", 1);
+    router.publish("int", 2);
+    // Delivering makes room for the spilled event, then for one more
+    EXPECT_TRUE(queue->deliver());
+    EXPECT_TRUE(queue->deliver());
+    // Neither may overtake the spilled event, nor overwrite it out of turn
+    router.publish("int", 3);
+    router.publish("int", 4);
+    while (queue->deliver());
+    ASSERT_EQ(3, received.size());
+    EXPECT_EQ(0, received[0]);
+    EXPECT_EQ(1, received[1]);
+    EXPECT_EQ(4, received[2]);
+    EXPECT_EQ(3, queue->stats().spilled);
+}
+
+// Listener that holds up the producer telling it until released
+struct SlowListener : public ReadyListener {
+    SlowListener() : entered(false), released(false), finished(false) { }
+
+    void ready(EventQueue&) {
+        entered.store(true);
+        while (!released.load()) boost::this_thread::yield();
+        finished.store(true);
+    }
+
+    boost::atomic<bool> entered;
+    boost::atomic<bool> released;
+    boost::atomic<bool> finished;
+};
+
+static void remove_listener(EventQueue* queue, ReadyListener* listener, boost::atomic<bool>* removed) {
+    queue->remove_ready_listener(listener);
+    removed->store(true);
+}
+
+TEST(EventRouter, event_queue_removes_listeners_after_notifying) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    SlowListener listener;
+    queue->add_ready_listener(&listener);
+    TopicId topic = router.topic("int");
+    boost::thread producer(boost::bind(&EventQueue::enqueue_value<int>, queue.get(), boost::ref(router), topic, 1));
+    while (!listener.entered.load()) boost::this_thread::yield();
+
+    // The producer copied the listener before it was removed, so removing
+    // it must wait until the producer has finished with it
+    boost::atomic<bool> removed(false);
+    boost::thread remover(boost::bind(remove_listener, queue.get(), &listener, &removed));
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+    EXPECT_FALSE(removed.load());
+    listener.released.store(true);
+    remover.join();
+    producer.join();
+    EXPECT_TRUE(listener.finished.load());
+    EXPECT_TRUE(removed.load());
+}
+
+static void drain_queue(EventQueue* queue, int count) {
+    for (int i = 0; i < count; ) {
+        if (queue->deliver()) i++;
+        else boost::this_thread::yield();
+    }
+}
+
+TEST(EventRouter, event_queue_can_block_producer) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    queue->set_capacity(2, BlockProducer);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    vector<int> received;
+    router.subscribe<int>("int").deliver_with2(boost::bind(append_int, &received, _1));
+    router.publish("int", 0);
+    router.publish("int", 1);
+
+    boost::thread consumer(boost::bind(drain_queue, queue.get(), 100));
+    for (int i = 2; i < 100; i++) router.publish("int", i);
+    consumer.join();
+    QueueStats stats = queue->stats();
+    EXPECT_LE(1, stats.blocked);
+    EXPECT_EQ(0, stats.dropped);
+    EXPECT_EQ(2, stats.high_water_mark);
+    ASSERT_EQ(100, received.size());
+    for (int i = 0; i < 100; i++) EXPECT_EQ(i, received[i]);
+}
+
+TEST(EventRouter, event_queue_delivers_by_priority) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    vector<int> received;
+    router.subscribe<int>("/alarm").deliver_with2(boost::bind(append_int, &received, _1));
+    router.subscribe<int>("/telemetry").deliver_with2(boost::bind(append_int, &received, _1));
+    queue->set_priority(router.topic("/alarm"), HighPriority);
+    queue->set_priority(router.topic("/telemetry"), LowPriority);
+    queue->set_starvation_limit(2);
+    EXPECT_EQ(HighPriority, queue->priority(router.topic("/alarm")));
+
+    for (int i = 0; i < 3; i++) router.publish("/telemetry", 100 + i);
+    for (int i = 0; i < 5; i++) router.publish("/alarm", i);
+    while (queue->deliver());
+
+    // Telemetry is delivered after alarms, except once passed over twice
+    ASSERT_EQ(8, received.size());
+    EXPECT_EQ(0, received[0]);
+    EXPECT_EQ(1, received[1]);
+    EXPECT_EQ(100, received[2]);
+    EXPECT_EQ(2, received[3]);
+    EXPECT_EQ(3, received[4]);
+    EXPECT_EQ(101, received[5]);
+    EXPECT_EQ(4, received[6]);
+    EXPECT_EQ(102, received[7]);
+
+    EXPECT_EQ(5, queue->lane_stats(HighPriority).delivered);
+    EXPECT_EQ(3, queue->lane_stats(LowPriority).delivered);
+    EXPECT_EQ(0, queue->lane_stats(NormalPriority).delivered);
+    EXPECT_LE(queue->lane_stats(LowPriority).mean_latency(),
+              queue->lane_stats(LowPriority).max_latency);
+}
+
+TEST(EventRouter, event_queue_drops_lowest_priority_first) {
+    std::tr1::shared_ptr<EventQueue> queue(new EventQueue);
+    queue->set_capacity(2, DropOldest);
+    QueueingDeliveryPolicy delivery(queue);
+    EventRouter router(delivery);
+    vector<int> received;
+    router.subscribe<int>("/alarm").deliver_with2(boost::bind(append_int, &received, _1));
+    router.subscribe<int>("/telemetry").deliver_with2(boost::bind(append_int, &received, _1));
+    queue->set_priority(router.topic("/alarm"), HighPriority);
+    router.publish("/alarm", 1);
+    router.publish("/telemetry", 2);
+    router.publish("/alarm", 3);
+    while (queue->deliver());
+    ASSERT_EQ(2, received.size());
+    EXPECT_EQ(1, received[0]);
+    EXPECT_EQ(3, received[1]);
+}
+
+TEST(EventRouter, can_subscribe_to_patterns) {
+    EventRouter router;
+    vector<int> motion;
+    vector<int> sensor;
+    router.publish("/motion/hoist", 0);
+    router.subscribe<int>("/motion/*").deliver_with2(boost::bind(append_int, &motion, _1));
+    router.subscribe<int>("/sensor/**").deliver_with2(boost::bind(append_int, &sensor, _1));
+
+    // Topics that existed before the subscription and those created after
+    router.publish("/motion/hoist", 1);
+    router.publish("/motion/drag", 2);
+    router.publish("/motion/drag/extra", 3);
+    router.publish("/sensor", 4);
+    router.publish("/sensor/inclinometer/pitch", 5);
+    router.publish("/sheave/drag", 6);
+
+    ASSERT_EQ(2, motion.size());
+    EXPECT_EQ(1, motion[0]);
+    EXPECT_EQ(2, motion[1]);
+    ASSERT_EQ(2, sensor.size());
+    EXPECT_EQ(4, sensor[0]);
+    EXPECT_EQ(5, sensor[1]);
+    EXPECT_EQ(1, router.signal_for("/motion/drag")->size());
+    EXPECT_TRUE(router.signal_for("/sheave/drag")->empty());
+}
+
+TEST(EventRouter, can_block_and_unsubscribe_patterns) {
+    EventRouter router;
+    int byref = 0;
+    Subscription<int> subscription = router.subscribe<int>("/motion/*").assign_to(&byref);
+    EXPECT_EQ(NO_TOPIC, subscription.topic());
+    router.publish("/motion/hoist", 1);
+    EXPECT_EQ(1, byref);
+    subscription.block();
+    router.publish("/motion/hoist", 2);
+    router.publish("/motion/drag", 3);
+    EXPECT_EQ(1, byref);
+    subscription.unblock();
+    router.publish("/motion/drag", 4);
+    EXPECT_EQ(4, byref);
+    subscription.unsubscribe();
+    router.publish("/motion/hoist", 5);
+    router.publish("/motion/swing", 6);
+    EXPECT_EQ(4, byref);
+    EXPECT_TRUE(router.signal_for("/motion/hoist")->empty());
+    EXPECT_TRUE(router.signal_for("/motion/swing")->empty());
+}
+
+TEST(EventRouter, can_route_patterns) {
+    EventRouter source;
+    EventRouter dest;
+    int hoist = 0;
+    int drag = 0;
+    dest.subscribe<int>("/motion/hoist").assign_to(&hoist);
+    dest.subscribe<int>("/motion/drag").assign_to(&drag);
+    source.route("/motion/*", dest);
+    source.publish("/motion/hoist", 1);
+    source.publish("/motion/drag", 2);
+    EXPECT_EQ(1, hoist);
+    EXPECT_EQ(2, drag);
+}
+
+TEST(EventRouter, resolves_routed_pattern_topics_when_matched) {
+    EventRouter source;
+    EventRouter dest;
+    source.route("/motion/*", dest);
+    source.topic("/motion/hoist");
+    // The destination topic exists before anything is published
+    EXPECT_EQ(1u, dest.topic_count());
+    source.topic("/payload/weight");
+    EXPECT_EQ(1u, dest.topic_count());
+
+    int hoist = 0;
+    dest.subscribe<int>("/motion/hoist").assign_to(&hoist);
+    source.publish("/motion/hoist", 3);
+    EXPECT_EQ(3, hoist);
+    EXPECT_THROW(source.route("/payload/*", source), std::invalid_argument);
+}
+
+TEST(EventRouter, cannot_publish_to_patterns) {
+    EventRouter router;
+    EXPECT_THROW(router.publish("/motion/*", 1), std::invalid_argument);
+}
+
+static void count_event(boost::atomic<int>* counter, const std::string&, const boost::any&) {
+    counter->fetch_add(1, boost::memory_order_relaxed);
+}
+
+static std::string stress_topic(int i) {
+    std::ostringstream name;
+    name << "/stress/" << i;
+    return name.str();
+}
+
+static void stress_publish(EventRouter* router, int topics, int count) {
+    for (int i = 0; i < count; i++) {
+        router->publish(stress_topic(i % topics), i);
+    }
+}
+
+// A publish already under way may call a delegate after it is unsubscribed,
+// so the counter must outlive the publishers
+static void stress_subscribe(EventRouter* router, boost::atomic<int>* received, int topics, int count) {
+    for (int i = 0; i < count; i++) {
+        Subscription<> subscription =
+            router->subscribe(stress_topic(i % topics), boost::bind(count_event, received, _1, _2));
+        subscription.unsubscribe();
+    }
+}
+
+TEST(EventRouter, supports_concurrent_publishers) {
+    const int PUBLISHERS = 4;
+    const int SUBSCRIBERS = 3;
+    const int TOPICS = 8;
+    const int EVENTS = 2000;
+
+    EventRouter router(EventRouter::MultiThreaded);
+    EXPECT_TRUE(router.is_concurrent());
+    boost::atomic<int> received(0);
+    boost::atomic<int> churned(0);
+    for (int i = 0; i < SUBSCRIBERS; i++) {
+        for (int t = 0; t < TOPICS; t++) {
+            router.subscribe(stress_topic(t), boost::bind(count_event, &received, _1, _2));
+        }
+    }
+
+    // Publishers run alongside threads which create topics and churn
+    // subscriptions on the topics being published
+    boost::thread_group threads;
+    for (int i = 0; i < PUBLISHERS; i++) {
+        threads.create_thread(boost::bind(stress_publish, &router, TOPICS, EVENTS));
+    }
+    threads.create_thread(boost::bind(stress_subscribe, &router, &churned, TOPICS * 4, EVENTS));
+    threads.create_thread(boost::bind(stress_subscribe, &router, &churned, TOPICS * 4, EVENTS));
+    threads.join_all();
+
+    EXPECT_EQ(PUBLISHERS * EVENTS * SUBSCRIBERS, received);
+    EXPECT_EQ(TOPICS * 4, router.topic_count());
+    for (int t = 0; t < TOPICS * 4; t++) {
+        EXPECT_EQ(t < TOPICS ? SUBSCRIBERS : 0, router.signal_for(stress_topic(t))->size());
+    }
+}
@@ -1,4 +1,5 @@
 #include <functional>
+#include <vector>
 #include <boost/any.hpp>
 #include <boost/bind.hpp>
 #include <gtest/gtest.h>
@@ -40,3 +41,161 @@ TEST(Module, can_create_and_receive_messages) {
     test.process_all();
     EXPECT_EQ("Hello Again World", test.stringValue);
 }
+
+class ConflatingModule : public Module {
+public:
+    ConflatingModule(EventRouter* router) :
+        Module(router),
+        position(0),
+        updates(0) {
+        set_queue_mode(Conflate);
+        bind_value("/motion/hoist", &position);
+        bind_fn<int>("/motion/update",
+                boost::bind(&ConflatingModule::update, this, _1), QueueAll);
+    }
+
+    void update(int) { updates++; }
+
+    int position;
+    int updates;
+};
+
+TEST(Module, can_conflate_bindings) {
+    EventRouter* router = new EventRouter();
+    ConflatingModule test(router);
+    for (int i = 1; i <= 10; i++) {
+        router->publish("/motion/hoist", i);
+        router->publish("/motion/update", i);
+    }
+    EXPECT_EQ(11, test.process_all());
+    EXPECT_EQ(10, test.position);
+    EXPECT_EQ(10, test.updates);
+}
+
+static void store_double(double* stored, const double& value) { *stored = value; }
+
+TEST(Module, binds_a_topic_with_different_types) {
+    // Modules given a plain pointer own the router, so share it instead
+    std::tr1::shared_ptr<EventRouter> router(new EventRouter());
+    Module as_value(router);
+    Module as_reference(router);
+    Module as_float(router);
+    double value = 0;
+    double referenced = 0;
+    float narrowed = 0;
+    as_value.bind_value("/payload/weight", &value);
+    as_reference.bind_fn<const double&>("/payload/weight", boost::bind(store_double, &referenced, _1));
+    // The channel carries double, so this binding is routed boxed instead
+    EXPECT_NO_THROW(as_float.bind_value("/payload/weight", &narrowed));
+
+    router->channel<double>("/payload/weight").publish(12.5);
+    as_value.process_all();
+    as_reference.process_all();
+    EXPECT_EQ(12.5, value);
+    EXPECT_EQ(12.5, referenced);
+    // Values must still be published with the bound type
+    EXPECT_THROW(as_float.process_all(), boost::bad_any_cast);
+    EXPECT_EQ(0, narrowed);
+}
+
+TEST(Module, fails_to_cast_untyped_values_when_processing) {
+    EventRouter* router = new EventRouter();
+    Module module(router);
+    double value = 0;
+    module.bind_value("/payload/weight", &value);
+    EXPECT_NO_THROW(router->publish("/payload/weight", 3));
+    EXPECT_THROW(module.process_all(), boost::bad_any_cast);
+    router->publish("/payload/weight", 4.5);
+    module.process_all();
+    EXPECT_EQ(4.5, value);
+}
+
+TEST(Module, can_bound_queue) {
+    EventRouter* router = new EventRouter();
+    TestModule test(router);
+    test.set_queue_capacity(2, DropNewest);
+    router->publish("string", std::string("first"));
+    router->publish("string", std::string("second"));
+    router->publish("string", std::string("third"));
+    QueueStats stats = test.queue_stats();
+    EXPECT_EQ(2, stats.size);
+    EXPECT_EQ(1, stats.dropped);
+    EXPECT_EQ(2, test.process_all());
+    EXPECT_EQ("second", test.stringValue);
+}
+
+class PriorityModule : public Module {
+public:
+    PriorityModule(EventRouter* router) : Module(router) {
+        bind_fn<int>("/telemetry", boost::bind(&PriorityModule::receive, this, _1), LowPriority);
+        bind_fn<int>("/alarm", boost::bind(&PriorityModule::receive, this, _1), Conflate, HighPriority);
+    }
+
+    void receive(int value) { received.push_back(value); }
+
+    vector<int> received;
+};
+
+TEST(Module, processes_high_priority_bindings_first) {
+    EventRouter* router = new EventRouter();
+    PriorityModule test(router);
+    router->publish("/telemetry", 1);
+    router->publish("/alarm", 2);
+    router->publish("/alarm", 3);
+    EXPECT_EQ(2, test.process_all());
+    ASSERT_EQ(2, test.received.size());
+    EXPECT_EQ(3, test.received[0]);
+    EXPECT_EQ(1, test.received[1]);
+    EXPECT_EQ(1, test.lane_stats(HighPriority).delivered);
+}
+
+class JoinModule : public Module {
+public:
+    JoinModule(EventRouter* router) :
+        Module(router),
+        cycles(0) {
+        Join& inputs = join(boost::bind(&JoinModule::compute, this),
+                            boost::chrono::milliseconds(10));
+        bind_value("/motion/hoist", &hoist, inputs);
+        bind_value("/motion/drag", &drag, inputs);
+        _inputs = &inputs;
+    }
+
+    void compute() { cycles++; }
+
+    const Join& inputs() const { return *_inputs; }
+
+    Timestamped<int> hoist;
+    Timestamped<int> drag;
+    int cycles;
+
+private:
+    Join* _inputs;
+};
+
+TEST(Module, join_fires_once_per_complete_cycle) {
+    EventRouter* router = new EventRouter();
+    JoinModule module(router);
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    boost::chrono::milliseconds ms(1);
+
+    router->publish("/motion/hoist", Timestamped<int>(1, now));
+    module.process_all();
+    EXPECT_EQ(0, module.cycles);
+    router->publish("/motion/drag", Timestamped<int>(2, now + 2 * ms));
+    router->publish("/motion/hoist", Timestamped<int>(3, now + 3 * ms));
+    module.process_all();
+    EXPECT_EQ(1, module.cycles);
+    EXPECT_EQ(2, *module.drag);
+
+    // Hoist is already fresh; a drag sample too far ahead discards it
+    router->publish("/motion/drag", Timestamped<int>(4, now + 50 * ms));
+    module.process_all();
+    EXPECT_EQ(1, module.cycles);
+    EXPECT_EQ(1u, module.inputs().discarded());
+
+    router->publish("/motion/hoist", Timestamped<int>(5, now + 52 * ms));
+    module.process_all();
+    EXPECT_EQ(2, module.cycles);
+    EXPECT_EQ(2u, module.inputs().cycles());
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <Supervisor.h>
 
 using namespace j2;
@@ -32,3 +33,297 @@ TEST(Supervisor, can_instantiate_module) {
     EXPECT_EQ(module.get(), supervisor.schedule().get());
     EXPECT_EQ("Hello World", module->stringValue);    
 }
+
+// Counts its events and records whether it was ever run by two threads at once
+class CountingModule : public Module {
+public:
+    CountingModule(std::tr1::shared_ptr<EventRouter> router) :
+        Module(router),
+        count(0),
+        running(false),
+        overlapped(false) {
+        bind_fn<int>("count", boost::bind(&CountingModule::increment, this, _1));
+    }
+
+    virtual int process(int n) {
+        if (running.exchange(true)) overlapped = true;
+        int processed = Module::process(n);
+        running.store(false);
+        return processed;
+    }
+
+    void increment(int) { count.fetch_add(1); }
+
+    boost::atomic<int> count;
+    boost::atomic<bool> running;
+    boost::atomic<bool> overlapped;
+};
+
+static void publish_counts(EventRouter* router, int n) {
+    for (int i = 0; i < n; i++) router->publish("count", i);
+}
+
+static bool processed_all(const std::vector<boost::shared_ptr<CountingModule> >& modules, int n) {
+    for (size_t i = 0; i < modules.size(); i++) {
+        if (modules[i]->count.load() != n) return false;
+    }
+    return true;
+}
+
+TEST(Supervisor, runs_modules_on_worker_threads) {
+    const int MODULES = 8;
+    const int EVENTS = 2000;
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    std::vector<boost::shared_ptr<CountingModule> > modules;
+    for (int i = 0; i < MODULES; i++) modules.push_back(supervisor.load<CountingModule>());
+
+    router->publish("count", -1);
+    supervisor.start(4);
+    EXPECT_TRUE(supervisor.is_running());
+
+    boost::thread_group producers;
+    for (int i = 0; i < 2; i++) {
+        producers.create_thread(boost::bind(publish_counts, router, EVENTS / 2));
+    }
+    producers.join_all();
+
+    boost::chrono::steady_clock::time_point deadline =
+        boost::chrono::steady_clock::now() + boost::chrono::seconds(10);
+    while (!processed_all(modules, EVENTS + 1) && boost::chrono::steady_clock::now() < deadline) {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+    supervisor.stop();
+    EXPECT_FALSE(supervisor.is_running());
+
+    for (int i = 0; i < MODULES; i++) {
+        EXPECT_EQ(EVENTS + 1, modules[i]->count.load());
+        EXPECT_FALSE(modules[i]->overlapped.load());
+    }
+}
+
+TEST(Supervisor, does_not_schedule_while_workers_run) {
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+    supervisor.start(1);
+    for (int i = 0; i < 100; i++) {
+        router->publish("count", i);
+        EXPECT_FALSE(supervisor.schedule());
+    }
+    EXPECT_EQ(0u, supervisor.poll());
+    supervisor.stop();
+    while (supervisor.schedule());
+    EXPECT_EQ(100, module->count.load());
+    EXPECT_FALSE(module->overlapped.load());
+}
+
+TEST(Supervisor, can_schedule_after_stopping_workers) {
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    supervisor.start(2);
+    supervisor.stop();
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+    router->publish("count", 1);
+    EXPECT_EQ(module.get(), supervisor.schedule().get());
+    EXPECT_EQ(1, module->count.load());
+}
+
+TEST(Supervisor, ready_set_scheduler_is_round_robin) {
+    EventRouter* router = new EventRouter;
+    ReadySetScheduler scheduler;
+    Supervisor supervisor(&scheduler, router);
+    boost::shared_ptr<CountingModule> first = supervisor.load<CountingModule>();
+    boost::shared_ptr<CountingModule> second = supervisor.load<CountingModule>();
+    EXPECT_FALSE(supervisor.schedule());
+
+    router->publish("count", 1);
+    router->publish("count", 2);
+    EXPECT_EQ(first.get(), supervisor.schedule().get());
+    EXPECT_EQ(second.get(), supervisor.schedule().get());
+    EXPECT_EQ(first.get(), supervisor.schedule().get());
+    EXPECT_EQ(second.get(), supervisor.schedule().get());
+    EXPECT_FALSE(supervisor.schedule());
+    EXPECT_EQ(2, first->count.load());
+    EXPECT_EQ(2, second->count.load());
+}
+
+TEST(Supervisor, ready_set_scheduler_resumes_after_workers_stop) {
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    ReadySetScheduler scheduler;
+    Supervisor supervisor(&scheduler, router);
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+    supervisor.start(1);
+    supervisor.stop();
+    router->publish("count", 1);
+    EXPECT_EQ(module.get(), supervisor.schedule().get());
+    EXPECT_FALSE(supervisor.schedule());
+}
+
+static void publish_then_interrupt(EventRouter* router, Supervisor* supervisor,
+                                   boost::shared_ptr<CountingModule> module) {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+    router->publish("count", 1);
+    while (module->count.load() == 0) boost::this_thread::yield();
+    supervisor->interrupt();
+}
+
+TEST(Supervisor, run_wakes_for_events) {
+    EventRouter* router = new EventRouter(EventRouter::MultiThreaded);
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+
+    boost::thread producer(boost::bind(publish_then_interrupt, router, &supervisor, module));
+    EXPECT_EQ(1u, supervisor.run_for(boost::chrono::seconds(10)));
+    producer.join();
+    EXPECT_EQ(1, module->count.load());
+    EXPECT_GE(supervisor.wake_stats().wakeups, 1u);
+}
+
+TEST(Supervisor, run_for_parks_until_timeout) {
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    supervisor.load<CountingModule>();
+    EventClock::time_point start = EventClock::now();
+    EXPECT_EQ(0u, supervisor.run_for(boost::chrono::milliseconds(30)));
+    EXPECT_GE(EventClock::now() - start, boost::chrono::milliseconds(30));
+}
+
+static void read_and_interrupt(int fd, Supervisor* supervisor, char* got) {
+    if (read(fd, got, 1) == 1) supervisor->interrupt();
+}
+
+TEST(Supervisor, run_watches_descriptors) {
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    char got = 0;
+    supervisor.watch(fds[0], boost::bind(read_and_interrupt, fds[0], &supervisor, &got));
+    ASSERT_EQ(1, write(fds[1], "x", 1));
+    supervisor.run_for(boost::chrono::seconds(10));
+    EXPECT_EQ('x', got);
+    supervisor.unwatch(fds[0]);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(Supervisor, records_module_telemetry) {
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<CountingModule> quiet = supervisor.load<CountingModule>();
+    supervisor.enable_telemetry();
+    boost::shared_ptr<CountingModule> loaded_later = supervisor.load<CountingModule>();
+    EXPECT_TRUE(loaded_later->is_telemetry_enabled());
+
+    for (int i = 0; i < 3; i++) router->publish("count", i);
+    quiet->process_all();
+    loaded_later->process(2);
+    loaded_later->process(2);
+
+    std::vector<ModuleStats> stats = supervisor.module_stats();
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ(3u, stats[0].events);
+    EXPECT_EQ(1u, stats[0].batches);
+    EXPECT_EQ(3u, stats[0].high_water_mark);
+    EXPECT_EQ(3u, stats[0].latency.count);
+    EXPECT_EQ(3u, stats[1].events);
+    EXPECT_EQ(2u, stats[1].batches);
+    // Only the first batch is timed
+    EXPECT_EQ(2u, stats[1].timed_events);
+    EXPECT_GT(stats[1].wall_time.count(), 0);
+    EXPECT_GT(stats[1].mean_wall_time().count(), 0);
+    EXPECT_GT(stats[1].latency.percentile(0.5).count(), 0);
+
+    quiet->enable_telemetry(false);
+    router->publish("count", 4);
+    quiet->process_all();
+    EXPECT_EQ(3u, quiet->telemetry().events);
+}
+
+TEST(Supervisor, times_a_sample_of_module_batches) {
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+    module->enable_telemetry();
+
+    for (unsigned i = 0; i < 2 * TELEMETRY_TIMED_BATCHES + 1; i++) {
+        router->publish("count", int(i));
+        module->process_one();
+    }
+    ModuleStats stats = module->telemetry();
+    EXPECT_EQ(2 * TELEMETRY_TIMED_BATCHES + 1, stats.events);
+    EXPECT_EQ(2 * TELEMETRY_TIMED_BATCHES + 1, stats.batches);
+    EXPECT_EQ(3u, stats.timed_events);
+}
+
+TEST(Supervisor, latency_histogram_buckets_by_power_of_two) {
+    LatencyHistogram histogram;
+    histogram.record(boost::chrono::nanoseconds(1));
+    histogram.record(boost::chrono::nanoseconds(3));
+    histogram.record(boost::chrono::nanoseconds(1000));
+    histogram.record(boost::chrono::microseconds(2));
+    LatencySnapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(4u, snapshot.count);
+    EXPECT_EQ(1u, snapshot.buckets[0]);
+    EXPECT_EQ(1u, snapshot.buckets[2]);
+    EXPECT_EQ(1u, snapshot.buckets[10]);
+    EXPECT_EQ(1u, snapshot.buckets[11]);
+    EXPECT_EQ(boost::chrono::nanoseconds(4), snapshot.percentile(0.5));
+    EXPECT_EQ(boost::chrono::nanoseconds(2048), snapshot.percentile(1.0));
+}
+
+static void count_task(boost::atomic<int>* count) {
+    count->fetch_add(1);
+}
+
+static void interrupt_when(Supervisor* supervisor, boost::atomic<int>* count, int n) {
+    if (count->load() >= n) supervisor->interrupt();
+}
+
+TEST(Supervisor, run_fires_timers) {
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    boost::shared_ptr<CountingModule> module = supervisor.load<CountingModule>();
+    boost::atomic<int> posted(0);
+
+    router->channel<EventClock::time_point>("/timer/tick");
+    supervisor.timers().schedule_after(boost::chrono::milliseconds(5),
+                                       PUBLISH_TIMER(*router, "/timer/tick"));
+    supervisor.timers().schedule_after(boost::chrono::milliseconds(10),
+                                       POST_TIMER(*module, boost::bind(count_task, &posted)));
+    supervisor.timers().schedule_after(boost::chrono::milliseconds(1),
+                                       POST_TIMER(*module, boost::bind(interrupt_when, &supervisor, &posted, 1)),
+                                       boost::chrono::milliseconds(1));
+    EventClock::time_point start = EventClock::now();
+    supervisor.run_for(boost::chrono::seconds(10));
+    EXPECT_EQ(1, posted.load());
+    EXPECT_GE(EventClock::now() - start, boost::chrono::milliseconds(10));
+}
+
+static void record_time(std::vector<EventClock::time_point>* times, EventClock::time_point) {
+    times->push_back(EventClock::now());
+}
+
+TEST(Supervisor, runs_faster_than_real_time_on_a_simulated_clock) {
+    // Start on a tick of the timer wheel, so the timers are due exactly
+    EventClock::time_point start(boost::chrono::hours(1));
+    SimulatedClock clock(start);
+    ScopedClockSource use(clock);
+    EventRouter* router = new EventRouter;
+    Supervisor supervisor(BasicScheduler::instance(), router);
+    std::vector<EventClock::time_point> times;
+    supervisor.timers().schedule(start + boost::chrono::seconds(1),
+                                 boost::bind(record_time, &times, _1),
+                                 boost::chrono::seconds(1));
+
+    boost::chrono::steady_clock::time_point real_start = boost::chrono::steady_clock::now();
+    supervisor.run_until(clock, start + boost::chrono::hours(1));
+    EXPECT_LT(boost::chrono::steady_clock::now() - real_start, boost::chrono::seconds(5));
+
+    ASSERT_EQ(3600u, times.size());
+    for (std::size_t i = 0; i < times.size(); i++) {
+        EXPECT_EQ(start + boost::chrono::seconds(i + 1), times[i]);
+    }
+    EXPECT_EQ(start + boost::chrono::hours(1), EventClock::now());
+}
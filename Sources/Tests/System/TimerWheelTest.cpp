@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <TimerWheel.h>
+
+using namespace j2;
+using namespace std;
+
+typedef std::vector<EventClock::time_point> Times;
+
+static void record_due(Times* times, EventClock::time_point due) {
+    times->push_back(due);
+}
+
+static boost::chrono::milliseconds ms(int n) {
+    return boost::chrono::milliseconds(n);
+}
+
+TEST(TimerWheel, fires_timers_when_due) {
+    EventClock::time_point start = EventClock::now();
+    TimerWheel wheel(ms(1), start);
+    Times fired;
+    wheel.schedule(start + ms(70000), boost::bind(record_due, &fired, _1));
+    wheel.schedule(start + ms(5), boost::bind(record_due, &fired, _1));
+    wheel.schedule(start + ms(300), boost::bind(record_due, &fired, _1));
+    EXPECT_EQ(3u, wheel.size());
+    EXPECT_EQ(start + ms(5), *wheel.next_expiry());
+
+    EXPECT_EQ(0u, wheel.advance(start + ms(4)));
+    EXPECT_EQ(1u, wheel.advance(start + ms(5)));
+    EXPECT_EQ(0u, wheel.advance(start + ms(299)));
+    EXPECT_EQ(1u, wheel.advance(start + ms(300)));
+    EXPECT_LE(*wheel.next_expiry(), start + ms(70000));
+    EXPECT_EQ(0u, wheel.advance(start + ms(69999)));
+    EXPECT_EQ(1u, wheel.advance(start + ms(70000)));
+
+    ASSERT_EQ(3u, fired.size());
+    EXPECT_EQ(start + ms(5), fired[0]);
+    EXPECT_EQ(start + ms(300), fired[1]);
+    EXPECT_EQ(start + ms(70000), fired[2]);
+    EXPECT_EQ(0u, wheel.size());
+    EXPECT_FALSE(wheel.next_expiry());
+}
+
+TEST(TimerWheel, can_cancel_timers) {
+    EventClock::time_point start = EventClock::now();
+    TimerWheel wheel(ms(1), start);
+    Times fired;
+    std::vector<TimerId> ids;
+    for (int i = 0; i < 1000; i++) {
+        ids.push_back(wheel.schedule(start + ms(i * 37 % 5000 + 1), boost::bind(record_due, &fired, _1)));
+    }
+    for (int i = 0; i < 1000; i += 2) EXPECT_TRUE(wheel.cancel(ids[i]));
+    EXPECT_FALSE(wheel.cancel(ids[0]));
+    EXPECT_FALSE(wheel.cancel(NO_TIMER));
+    EXPECT_EQ(500u, wheel.size());
+
+    EXPECT_EQ(500u, wheel.advance(start + ms(5000)));
+    EXPECT_EQ(500u, fired.size());
+    for (std::size_t i = 1; i < fired.size(); i++) EXPECT_LE(fired[i - 1], fired[i]);
+    EXPECT_FALSE(wheel.cancel(ids[1]));
+}
+
+TEST(TimerWheel, repeats_periodic_timers) {
+    EventClock::time_point start = EventClock::now();
+    TimerWheel wheel(ms(1), start);
+    Times fired;
+    TimerId id = wheel.schedule(start + ms(10), boost::bind(record_due, &fired, _1), ms(10));
+    EXPECT_EQ(1u, wheel.advance(start + ms(10)));
+    EXPECT_EQ(1u, wheel.advance(start + ms(20)));
+    // Periods missed between calls to advance are skipped
+    EXPECT_EQ(1u, wheel.advance(start + ms(55)));
+    EXPECT_EQ(start + ms(60), *wheel.next_expiry());
+    EXPECT_EQ(1u, wheel.advance(start + ms(60)));
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_EQ(0u, wheel.advance(start + ms(1000)));
+    ASSERT_EQ(4u, fired.size());
+    EXPECT_EQ(start + ms(30), fired[2]);
+}
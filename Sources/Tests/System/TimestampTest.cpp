@@ -86,3 +86,46 @@ TEST(Timestamp, can_nest_timestamped_set) {
 
 
 
+
+TEST(Timestamp, incremental_set_tracks_assignments) {
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    IncrementalTimestampedSet<50, milliseconds> incremental;
+    TimestampedSet<50, milliseconds> scanned;
+    Timestamped<int> x(1, now);
+    Timestamped<float> y(1.0, now + milliseconds(10));
+    Timestamped<double> z(1.0, now + milliseconds(20));
+    incremental += x, y, z;
+    scanned += x, y, z;
+    EXPECT_TRUE(incremental.is_synchronized());
+    EXPECT_EQ(now, incremental.min());
+    EXPECT_EQ(now + milliseconds(20), incremental.timestamp());
+
+    for (int i = 1; i < 100; i++) {
+        boost::random::uniform_int_distribution<int> dist(0, 60);
+        x = Timestamped<int>(i, now + milliseconds(10 * i + dist(gen)));
+        y = Timestamped<float>(i, now + milliseconds(10 * i + dist(gen)));
+        if (i % 3 == 0) z = Timestamped<double>(i, now + milliseconds(10 * i + dist(gen)));
+        EXPECT_EQ(scanned.min(), incremental.min());
+        EXPECT_EQ(scanned.max(), incremental.max());
+        EXPECT_EQ(scanned.is_synchronized(), incremental.is_synchronized());
+    }
+}
+
+TEST(Timestamp, incremental_set_forgets_destroyed_members) {
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    IncrementalTimestampedSet<50, milliseconds> set;
+    Timestamped<int> x(1, now);
+    set += x;
+    {
+        Timestamped<int> late(2, now + milliseconds(100));
+        set += late;
+        EXPECT_FALSE(set.is_synchronized());
+    }
+    EXPECT_TRUE(set.is_synchronized());
+    EXPECT_EQ(now, set.max());
+
+    // Copies are not members
+    Timestamped<int> copy(x);
+    copy = Timestamped<int>(3, now + milliseconds(100));
+    EXPECT_EQ(now, set.max());
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <Module.h>
+#include "TimestampedHistory.h"
+
+using namespace j2;
+using boost::chrono::milliseconds;
+
+TEST(TimestampedHistory, keeps_latest_samples_in_order) {
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    TimestampedHistory<double, 3> history;
+    EXPECT_TRUE(history.empty());
+    EXPECT_FALSE(history.at(now));
+
+    history.push(Timestamped<double>(1.0, now));
+    history.push(Timestamped<double>(3.0, now + milliseconds(20)));
+    history.push(Timestamped<double>(2.0, now + milliseconds(10)));
+    history.push(Timestamped<double>(4.0, now + milliseconds(30)));
+    ASSERT_EQ(3u, history.size());
+    EXPECT_EQ(2.0, *history[0]);
+    EXPECT_EQ(3.0, *history[1]);
+    EXPECT_EQ(4.0, *history.latest());
+    EXPECT_EQ(now + milliseconds(10), history.min());
+    EXPECT_EQ(now + milliseconds(30), history.timestamp());
+
+    // Too old to keep once full
+    history.push(Timestamped<double>(0.0, now));
+    EXPECT_EQ(2.0, *history[0]);
+}
+
+TEST(TimestampedHistory, interpolates_between_samples) {
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    TimestampedHistory<double, 8> history;
+    history.push(Timestamped<double>(10.0, now));
+    history.push(Timestamped<double>(20.0, now + milliseconds(10)));
+    history.push(Timestamped<double>(0.0, now + milliseconds(50)));
+
+    EXPECT_DOUBLE_EQ(10.0, *history.at(now));
+    EXPECT_DOUBLE_EQ(15.0, *history.at(now + milliseconds(5)));
+    EXPECT_DOUBLE_EQ(20.0, *history.at(now + milliseconds(10)));
+    EXPECT_DOUBLE_EQ(10.0, *history.at(now + milliseconds(30)));
+    EXPECT_FALSE(history.at(now - milliseconds(1)));
+    EXPECT_FALSE(history.at(now + milliseconds(51)));
+
+    boost::optional< Timestamped<double> > sample = history.sample(now + milliseconds(40));
+    ASSERT_TRUE(sample);
+    EXPECT_DOUBLE_EQ(5.0, **sample);
+    EXPECT_EQ(now + milliseconds(40), sample->timestamp());
+}
+
+class HistoryModule : public Module {
+public:
+    HistoryModule(EventRouter* router) : Module(router) {
+        bind_value("/motion/hoist", &hoist);
+    }
+
+    TimestampedHistory<double, 16> hoist;
+};
+
+TEST(TimestampedHistory, can_bind_to_module) {
+    EventRouter* router = new EventRouter();
+    HistoryModule module(router);
+    Timestampable::Timestamp now = Timestampable::Clock::now();
+    router->publish("/motion/hoist", Timestamped<double>(1.0, now));
+    router->publish("/motion/hoist", Timestamped<double>(3.0, now + milliseconds(2)));
+    module.process_all();
+    ASSERT_EQ(2u, module.hoist.size());
+    EXPECT_DOUBLE_EQ(2.0, *module.hoist.at(now + milliseconds(1)));
+}
@@ -0,0 +1,52 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <TopicTrie.h>
+
+using namespace j2;
+using namespace std;
+
+TEST(TopicTrie, splits_segments) {
+    vector<string> segments = topic_segments("/sensor/inclinometer/pitch");
+    ASSERT_EQ(4, segments.size());
+    EXPECT_EQ("", segments[0]);
+    EXPECT_EQ("sensor", segments[1]);
+    EXPECT_EQ("pitch", segments[3]);
+}
+
+TEST(TopicTrie, matches_wildcards) {
+    EXPECT_TRUE(TopicTrie<int>::matches("/motion/hoist", "/motion/hoist"));
+    EXPECT_FALSE(TopicTrie<int>::matches("/motion/hoist", "/motion/drag"));
+
+    EXPECT_TRUE(TopicTrie<int>::matches("/motion/*", "/motion/hoist"));
+    EXPECT_FALSE(TopicTrie<int>::matches("/motion/*", "/motion"));
+    EXPECT_FALSE(TopicTrie<int>::matches("/motion/*", "/motion/hoist/position"));
+    EXPECT_TRUE(TopicTrie<int>::matches("/*/drag", "/sheave/drag"));
+
+    EXPECT_TRUE(TopicTrie<int>::matches("/sensor/**", "/sensor"));
+    EXPECT_TRUE(TopicTrie<int>::matches("/sensor/**", "/sensor/inclinometer/pitch"));
+    EXPECT_FALSE(TopicTrie<int>::matches("/sensor/**", "/motion/hoist"));
+    EXPECT_TRUE(TopicTrie<int>::matches("/**/pitch", "/sensor/inclinometer/pitch"));
+    EXPECT_TRUE(TopicTrie<int>::matches("/**", "/motion/hoist"));
+}
+
+TEST(TopicTrie, finds_each_matching_pattern_once) {
+    TopicTrie<int> trie;
+    trie.insert("/motion/*", 1);
+    trie.insert("/motion/hoist", 2);
+    trie.insert("/**/**", 3);
+    trie.insert("/sensor/**", 4);
+
+    vector<int> found;
+    trie.match("/motion/hoist", found);
+    ASSERT_EQ(3, found.size());
+    EXPECT_EQ(1, found[0]);
+    EXPECT_EQ(2, found[1]);
+    EXPECT_EQ(3, found[2]);
+
+    EXPECT_TRUE(trie.erase("/motion/*", 1));
+    EXPECT_FALSE(trie.erase("/motion/*", 1));
+    found.clear();
+    trie.match("/motion/hoist", found);
+    EXPECT_EQ(2, found.size());
+}
@@ -1,3 +1,5 @@
+#include <vector>
+#include <iterator>
 #include <tr1/memory>
 #include <gtest/gtest.h>
 #include "blocking_queue.h"
@@ -66,9 +68,9 @@ TEST(blocking_queue, can_have_multiple_readers_and_writers) {
         threads.push_back(new boost::thread(p));
     }
     for (int i=0; i<32; i++) {
-        int* i = new int;
-        results.push_back(i);
-        consumer c(queue, i);
+        int* r = new int;
+        results.push_back(r);
+        consumer c(queue, r);
         threads.push_back(new boost::thread(c));
     }
 
@@ -76,7 +78,7 @@ TEST(blocking_queue, can_have_multiple_readers_and_writers) {
     for_each(threads.begin(), threads.end(), &join_and_free);
 
     // Check results
-    uint32_t got_result;
+    uint32_t got_result = 0;
     for (vector< int* >::iterator it = results.begin();
          it != results.end();
          ++it) {
@@ -87,3 +89,43 @@ TEST(blocking_queue, can_have_multiple_readers_and_writers) {
     EXPECT_EQ(0xffffffff, got_result);
 }
 
+
+TEST(blocking_queue, can_deq_in_batches) {
+    blocking_queue<int> queue;
+    for (int i = 0; i < 5; i++) queue.enq(i);
+    vector<int> items;
+    EXPECT_EQ(2, queue.deq_up_to(2, back_inserter(items)));
+    EXPECT_EQ(3, queue.deq_all(back_inserter(items)));
+    EXPECT_TRUE(queue.empty());
+    ASSERT_EQ(5, items.size());
+    for (int i = 0; i < 5; i++) EXPECT_EQ(i, items[i]);
+}
+
+TEST(blocking_queue, can_deq_with_timeout) {
+    blocking_queue<int> queue;
+    EXPECT_FALSE(queue.deq_for(boost::chrono::milliseconds(10)));
+    queue.enq(99);
+    boost::optional<int> result = queue.deq_until(boost::chrono::steady_clock::now() +
+                                                  boost::chrono::milliseconds(10));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(99, *result);
+}
+
+static void close_queue(blocking_queue<int>* queue) {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    queue->close();
+}
+
+TEST(blocking_queue, close_releases_waiters) {
+    blocking_queue<int> queue;
+    queue.enq(1);
+    boost::thread closer(boost::bind(close_queue, &queue));
+    vector<int> items;
+    EXPECT_EQ(1, queue.deq_all(back_inserter(items)));
+    EXPECT_EQ(0, queue.deq_all(back_inserter(items)));
+    closer.join();
+    EXPECT_TRUE(queue.is_closed());
+    EXPECT_FALSE(queue.deq_for(boost::chrono::seconds(10)));
+    EXPECT_THROW(queue.deq(), queue_closed);
+    EXPECT_THROW(queue.enq(2), queue_closed);
+}
@@ -0,0 +1,105 @@
+#include <vector>
+#include <iterator>
+#include <gtest/gtest.h>
+#include "ring_queue.h"
+
+using namespace std;
+using namespace j2;
+
+TEST(ring_queue, can_enq_and_deq_without_blocking) {
+    spsc_queue<int> spsc(4);
+    mpsc_queue<int> mpsc(4);
+    EXPECT_EQ(4, spsc.capacity());
+    EXPECT_TRUE(spsc.empty());
+    spsc.enq(99);
+    mpsc.enq(99);
+    EXPECT_EQ(1, spsc.size());
+    EXPECT_EQ(1, mpsc.size());
+    EXPECT_EQ(99, spsc.deq());
+    EXPECT_EQ(99, mpsc.deq());
+    EXPECT_TRUE(spsc.empty());
+    EXPECT_TRUE(mpsc.empty());
+
+    int item;
+    EXPECT_FALSE(spsc.try_deq(item));
+    EXPECT_FALSE(mpsc.try_deq(item));
+}
+
+TEST(ring_queue, try_enq_fails_when_full) {
+    spsc_queue<int> spsc(2);
+    mpsc_queue<int> mpsc(2);
+    EXPECT_TRUE(spsc.try_enq(1));
+    EXPECT_TRUE(spsc.try_enq(2));
+    EXPECT_FALSE(spsc.try_enq(3));
+    EXPECT_TRUE(mpsc.try_enq(1));
+    EXPECT_TRUE(mpsc.try_enq(2));
+    EXPECT_FALSE(mpsc.try_enq(3));
+
+    // Wrap around
+    int item;
+    for (int i = 3; i < 10; i++) {
+        EXPECT_TRUE(spsc.try_deq(item));
+        EXPECT_EQ(i - 2, item);
+        EXPECT_TRUE(spsc.try_enq(i));
+        EXPECT_TRUE(mpsc.try_deq(item));
+        EXPECT_EQ(i - 2, item);
+        EXPECT_TRUE(mpsc.try_enq(i));
+    }
+}
+
+TEST(ring_queue, can_deq_n) {
+    mpsc_queue<int> queue(8);
+    for (int i = 0; i < 5; i++) queue.enq(i);
+    vector<int> items;
+    EXPECT_EQ(3, queue.deq_n(back_inserter(items), 3));
+    EXPECT_EQ(2, queue.deq_n(back_inserter(items), 3));
+    ASSERT_EQ(5, items.size());
+    for (int i = 0; i < 5; i++) EXPECT_EQ(i, items[i]);
+}
+
+template <class Queue>
+static void produce(Queue* queue, int first, int count) {
+    for (int i = first; i < first + count; i++) queue->enq(i);
+}
+
+TEST(ring_queue, spsc_preserves_order_across_threads) {
+    const int COUNT = 100000;
+    spsc_queue<int> queue(16);
+    boost::thread producer(boost::bind(produce< spsc_queue<int> >, &queue, 0, COUNT));
+    for (int i = 0; i < COUNT; i++) {
+        int item = queue.deq();
+        if (item != i) {
+            EXPECT_EQ(i, item);
+            break;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ring_queue, mpsc_delivers_from_multiple_producers) {
+    const int PRODUCERS = 4;
+    const int COUNT = 20000;
+    mpsc_queue<int> queue(16);
+    boost::thread_group producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.create_thread(boost::bind(produce< mpsc_queue<int> >, &queue, p * COUNT, COUNT));
+    }
+
+    // Items from each producer arrive in the order it sent them
+    vector<int> next(PRODUCERS);
+    for (int p = 0; p < PRODUCERS; p++) next[p] = p * COUNT;
+    vector<int> items;
+    int received = 0;
+    while (received < PRODUCERS * COUNT) {
+        items.clear();
+        received += queue.deq_n(back_inserter(items), 64);
+        for (vector<int>::iterator it = items.begin(); it != items.end(); ++it) {
+            int p = *it / COUNT;
+            ASSERT_EQ(next[p], *it);
+            next[p]++;
+        }
+    }
+    producers.join_all();
+    EXPECT_TRUE(queue.empty());
+}
@@ -156,3 +156,20 @@ TEST(MemoryIoWriter, chaining_writes) {
     EXPECT_FALSE(writer.hasError());    
 }
 
+
+TEST(SpanIoReader, reads_borrowed_bytes) {
+    uint8_t TEST_DATA[] = { 0xca, 0xfe, 0x01 };
+    ByteSpan span(TEST_DATA, sizeof(TEST_DATA));
+    EXPECT_EQ(0xcafe, span.uint16_at(0));
+    EXPECT_EQ(1u, span.subspan(2).size());
+    EXPECT_TRUE(span.subspan(3).empty());
+
+    SpanIoReader reader(span);
+    uint16_t doubleByte;
+    reader.read(&doubleByte);
+    EXPECT_EQ(0xcafe, doubleByte);
+    EXPECT_EQ(0x01, reader.readByte());
+    EXPECT_TRUE(reader.isEof());
+    reader.readByte();
+    EXPECT_TRUE(reader.hasError());
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <stdexcept>
 #include <tr1/memory>
 #include <inttypes.h>
@@ -18,6 +19,43 @@ namespace j2 {
     /** @brief Pointer to a shared buffer */
     typedef std::tr1::shared_ptr<buffer> shared_buffer;
 
+    /**
+     * @brief Bytes borrowed from a buffer owned elsewhere, such as a receive
+     * buffer, which must outlive the span and not be resized while it is used.
+     */
+    class ByteSpan {
+    public:
+        ByteSpan() : _data(0), _size(0) { }
+
+        ByteSpan(const uint8_t* data, std::size_t size) : _data(data), _size(size) { }
+
+        explicit ByteSpan(const buffer& bytes) :
+            _data(bytes.empty() ? 0 : &bytes[0]), _size(bytes.size()) { }
+
+        const uint8_t* data() const { return _data; }
+
+        std::size_t size() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+        uint8_t operator[](std::size_t i) const { return _data[i]; }
+
+        /** @brief Big endian 16-bit value at byte @c offset. */
+        uint16_t uint16_at(std::size_t offset) const {
+            return uint16_t((_data[offset] << 8) | _data[offset + 1]);
+        }
+
+        /** @brief Up to @c count bytes from @c offset; empty if past the end. */
+        ByteSpan subspan(std::size_t offset, std::size_t count = std::size_t(-1)) const {
+            if (offset >= _size) return ByteSpan();
+            return ByteSpan(_data + offset, std::min(count, _size - offset));
+        }
+
+    private:
+        const uint8_t* _data;
+        std::size_t _size;
+    };
+
     class Io {
     public:
         virtual void close() = 0;
@@ -196,6 +234,32 @@ namespace j2 {
         int _i;
     };
 
+    /** An Io wrapper that reads from borrowed bytes without copying them. */
+    class SpanIoReader : public IoReader {
+    public:
+        SpanIoReader(ByteSpan bytes) : _bytes(bytes), _i(0) { }
+
+        virtual uint8_t readByte() {
+            if (hasError()) return 0;
+            if (isEof()) {
+                // Attempted to read past end of span
+                error(true);
+                return 0;
+            }
+            return _bytes[_i++];
+        }
+
+        virtual void close() { }
+
+        virtual bool isEof() const {
+            return _i >= _bytes.size();
+        }
+
+    private:
+        ByteSpan _bytes;
+        std::size_t _i;
+    };
+
     /** An Io wrapper that appends to a vector of bytes. */
     class MemoryIoWriter : public IoWriter {
     public:
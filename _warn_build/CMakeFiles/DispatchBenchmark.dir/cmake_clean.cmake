@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DispatchBenchmark.dir/Benchmarks/DispatchBenchmark.cpp.o"
+  "CMakeFiles/DispatchBenchmark.dir/Benchmarks/DispatchBenchmark.cpp.o.d"
+  "DispatchBenchmark"
+  "DispatchBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DispatchBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,124 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/repo/Sources/CMakeLists.txt"
+  "/root/repo/Sources/Config/CMakeLists.txt"
+  "/root/repo/Sources/Config/config.h.in"
+  "/root/repo/Sources/Doc/CMakeLists.txt"
+  "/root/repo/Sources/Geometry/CMakeLists.txt"
+  "/root/repo/Sources/Modbus/CMakeLists.txt"
+  "/root/repo/Sources/System/CMakeLists.txt"
+  "/root/repo/Sources/Tests/Modbus/ModbusClientTest.cpp"
+  "/root/repo/Sources/Tests/Modbus/ModbusFrameTest.cpp"
+  "/root/repo/Sources/Tests/Modbus/ModbusPduTest.cpp"
+  "/root/repo/Sources/Tests/Modbus/ModbusServerTest.cpp"
+  "/root/repo/Sources/Tests/Modbus/ModbusTcpMessageTest.cpp"
+  "/root/repo/Sources/Tests/System/ClockTest.cpp"
+  "/root/repo/Sources/Tests/System/DeadlineSchedulerTest.cpp"
+  "/root/repo/Sources/Tests/System/DispatcherTest.cpp"
+  "/root/repo/Sources/Tests/System/EventRouterTest.cpp"
+  "/root/repo/Sources/Tests/System/ModuleTest.cpp"
+  "/root/repo/Sources/Tests/System/SupervisorTest.cpp"
+  "/root/repo/Sources/Tests/System/TimerWheelTest.cpp"
+  "/root/repo/Sources/Tests/System/TimestampTest.cpp"
+  "/root/repo/Sources/Tests/System/TimestampedHistoryTest.cpp"
+  "/root/repo/Sources/Tests/System/TopicTrieTest.cpp"
+  "/root/repo/Sources/Tests/System/blocking_queueTest.cpp"
+  "/root/repo/Sources/Tests/System/ring_queueTest.cpp"
+  "/root/repo/Sources/Tests/Util/IoTest.cpp"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_atomic-1.74.0/boost_atomic-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_atomic-1.74.0/boost_atomic-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_atomic-1.74.0/libboost_atomic-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_atomic-1.74.0/libboost_atomic-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_chrono-1.74.0/boost_chrono-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_chrono-1.74.0/boost_chrono-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_chrono-1.74.0/libboost_chrono-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_chrono-1.74.0/libboost_chrono-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_thread-1.74.0/boost_thread-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_thread-1.74.0/boost_thread-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_thread-1.74.0/libboost_thread-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_thread-1.74.0/libboost_thread-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindDoxygen.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "config.h"
+  "Config/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "System/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Modbus/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Geometry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/dsm.dir/DependInfo.cmake"
+  "CMakeFiles/unittest-all.dir/DependInfo.cmake"
+  "CMakeFiles/DispatchBenchmark.dir/DependInfo.cmake"
+  "CMakeFiles/ModbusBenchmark.dir/DependInfo.cmake"
+  "CMakeFiles/ModbusParseBenchmark.dir/DependInfo.cmake"
+  "CMakeFiles/QueueBenchmark.dir/DependInfo.cmake"
+  "CMakeFiles/RoutingBenchmark.dir/DependInfo.cmake"
+  "CMakeFiles/SupervisorBenchmark.dir/DependInfo.cmake"
+  "System/CMakeFiles/System.dir/DependInfo.cmake"
+  "Modbus/CMakeFiles/Modbus.dir/DependInfo.cmake"
+  "Geometry/CMakeFiles/Geometry.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Sources/Benchmarks/ModbusBenchmark.cpp" "CMakeFiles/ModbusBenchmark.dir/Benchmarks/ModbusBenchmark.cpp.o" "gcc" "CMakeFiles/ModbusBenchmark.dir/Benchmarks/ModbusBenchmark.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/Modbus/CMakeFiles/Modbus.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/System/CMakeFiles/System.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/Geometry/CMakeFiles/Geometry.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
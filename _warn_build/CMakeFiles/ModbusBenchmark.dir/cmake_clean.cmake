@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ModbusBenchmark.dir/Benchmarks/ModbusBenchmark.cpp.o"
+  "CMakeFiles/ModbusBenchmark.dir/Benchmarks/ModbusBenchmark.cpp.o.d"
+  "ModbusBenchmark"
+  "ModbusBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ModbusBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ModbusParseBenchmark.dir/Benchmarks/ModbusParseBenchmark.cpp.o"
+  "CMakeFiles/ModbusParseBenchmark.dir/Benchmarks/ModbusParseBenchmark.cpp.o.d"
+  "ModbusParseBenchmark"
+  "ModbusParseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ModbusParseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
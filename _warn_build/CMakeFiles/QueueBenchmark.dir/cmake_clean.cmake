@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/QueueBenchmark.dir/Benchmarks/QueueBenchmark.cpp.o"
+  "CMakeFiles/QueueBenchmark.dir/Benchmarks/QueueBenchmark.cpp.o.d"
+  "QueueBenchmark"
+  "QueueBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/QueueBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
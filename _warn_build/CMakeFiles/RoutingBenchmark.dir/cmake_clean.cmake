@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RoutingBenchmark.dir/Benchmarks/RoutingBenchmark.cpp.o"
+  "CMakeFiles/RoutingBenchmark.dir/Benchmarks/RoutingBenchmark.cpp.o.d"
+  "RoutingBenchmark"
+  "RoutingBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RoutingBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
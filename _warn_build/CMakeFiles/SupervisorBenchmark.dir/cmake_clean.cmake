@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SupervisorBenchmark.dir/Benchmarks/SupervisorBenchmark.cpp.o"
+  "CMakeFiles/SupervisorBenchmark.dir/Benchmarks/SupervisorBenchmark.cpp.o.d"
+  "SupervisorBenchmark"
+  "SupervisorBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SupervisorBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Sources/Tests/Config/ConfigTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Config/ConfigTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Config/ConfigTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Modbus/ModbusClientTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusClientTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusClientTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Modbus/ModbusFrameTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusFrameTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusFrameTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Modbus/ModbusPduTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusPduTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusPduTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Modbus/ModbusServerTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusServerTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusServerTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Modbus/ModbusTcpMessageTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusTcpMessageTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusTcpMessageTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/ClockTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/ClockTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/ClockTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/DeadlineSchedulerTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/DeadlineSchedulerTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/DeadlineSchedulerTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/DispatcherTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/DispatcherTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/DispatcherTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/EventRouterTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/EventRouterTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/EventRouterTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/ModuleTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/ModuleTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/ModuleTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/SupervisorTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/SupervisorTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/SupervisorTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/TimerWheelTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/TimerWheelTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/TimerWheelTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/TimestampTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/TimestampTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/TimestampTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/TimestampedHistoryTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/TimestampedHistoryTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/TimestampedHistoryTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/TopicTrieTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/TopicTrieTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/TopicTrieTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/blocking_queueTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/blocking_queueTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/blocking_queueTest.cpp.o.d"
+  "/root/repo/Sources/Tests/System/ring_queueTest.cpp" "CMakeFiles/unittest-all.dir/Tests/System/ring_queueTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/System/ring_queueTest.cpp.o.d"
+  "/root/repo/Sources/Tests/Util/IoTest.cpp" "CMakeFiles/unittest-all.dir/Tests/Util/IoTest.cpp.o" "gcc" "CMakeFiles/unittest-all.dir/Tests/Util/IoTest.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/Modbus/CMakeFiles/Modbus.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/System/CMakeFiles/System.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/Geometry/CMakeFiles/Geometry.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,47 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unittest-all.dir/Tests/Config/ConfigTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Config/ConfigTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusClientTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusClientTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusFrameTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusFrameTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusPduTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusPduTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusServerTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusServerTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusTcpMessageTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Modbus/ModbusTcpMessageTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/ClockTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/ClockTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/DeadlineSchedulerTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/DeadlineSchedulerTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/DispatcherTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/DispatcherTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/EventRouterTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/EventRouterTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/ModuleTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/ModuleTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/SupervisorTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/SupervisorTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimerWheelTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimerWheelTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimestampTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimestampTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimestampedHistoryTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/TimestampedHistoryTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/TopicTrieTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/TopicTrieTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/blocking_queueTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/blocking_queueTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/System/ring_queueTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/System/ring_queueTest.cpp.o.d"
+  "CMakeFiles/unittest-all.dir/Tests/Util/IoTest.cpp.o"
+  "CMakeFiles/unittest-all.dir/Tests/Util/IoTest.cpp.o.d"
+  "unittest-all"
+  "unittest-all.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unittest-all.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,239 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/Sources
+# Build directory: /root/repo/_warn_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ModbusClient.matches_pipelined_responses_by_transaction_id "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.matches_pipelined_responses_by_transaction_id" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.matches_pipelined_responses_by_transaction_id PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusClient.queues_requests_beyond_the_pipeline "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.queues_requests_beyond_the_pipeline" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.queues_requests_beyond_the_pipeline PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusClient.writes_registers_and_reports_exceptions "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.writes_registers_and_reports_exceptions" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.writes_registers_and_reports_exceptions PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusClient.requests_and_decodes_pdus "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.requests_and_decodes_pdus" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.requests_and_decodes_pdus PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusClient.fails_requests_that_time_out_or_lose_the_connection "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.fails_requests_that_time_out_or_lose_the_connection" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.fails_requests_that_time_out_or_lose_the_connection PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusClient.delivers_responses_received_with_the_close "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusClient.delivers_responses_received_with_the_close" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusClient.delivers_responses_received_with_the_close PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusFrame.parses_registers_in_place "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusFrame.parses_registers_in_place" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusFrame.parses_registers_in_place PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusFrame.needs_whole_frames "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusFrame.needs_whole_frames" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusFrame.needs_whole_frames PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusFrame.parses_requests_and_exceptions "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusFrame.parses_requests_and_exceptions" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusFrame.parses_requests_and_exceptions PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusFrame.client_delivers_frames_in_place "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusFrame.client_delivers_frames_in_place" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusFrame.client_delivers_frames_in_place PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusPdu.decodes_and_encodes_requests "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusPdu.decodes_and_encodes_requests" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusPdu.decodes_and_encodes_requests PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusPdu.decodes_and_encodes_responses "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusPdu.decodes_and_encodes_responses" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusPdu.decodes_and_encodes_responses PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusPdu.rejects_malformed_messages "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusPdu.rejects_malformed_messages" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusPdu.rejects_malformed_messages PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusServer.serves_register_image "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusServer.serves_register_image" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusServer.serves_register_image PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusServer.serves_hundreds_of_clients_on_one_thread "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusServer.serves_hundreds_of_clients_on_one_thread" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusServer.serves_hundreds_of_clients_on_one_thread PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusServer.sends_pending_responses_once_writable "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusServer.sends_pending_responses_once_writable" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusServer.sends_pending_responses_once_writable PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusServer.rejects_unsupported_functions "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusServer.rejects_unsupported_functions" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusServer.rejects_unsupported_functions PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ModbusServer.updates_register_image_from_topics "/root/repo/_warn_build/unittest-all" "--gtest_filter=ModbusServer.updates_register_image_from_topics" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ModbusServer.updates_register_image_from_topics PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Modbus.read_holding_registers "/root/repo/_warn_build/unittest-all" "--gtest_filter=Modbus.read_holding_registers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Modbus.read_holding_registers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Modbus.write_multiple_registers "/root/repo/_warn_build/unittest-all" "--gtest_filter=Modbus.write_multiple_registers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Modbus.write_multiple_registers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Modbus.read_from_file "/root/repo/_warn_build/unittest-all" "--gtest_filter=Modbus.read_from_file" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Modbus.read_from_file PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Clock.follows_steady_clock_by_default "/root/repo/_warn_build/unittest-all" "--gtest_filter=Clock.follows_steady_clock_by_default" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Clock.follows_steady_clock_by_default PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Clock.can_simulate_time "/root/repo/_warn_build/unittest-all" "--gtest_filter=Clock.can_simulate_time" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Clock.can_simulate_time PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(DeadlineScheduler.runs_released_modules_before_events "/root/repo/_warn_build/unittest-all" "--gtest_filter=DeadlineScheduler.runs_released_modules_before_events" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(DeadlineScheduler.runs_released_modules_before_events PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(DeadlineScheduler.orders_by_deadline_or_rate "/root/repo/_warn_build/unittest-all" "--gtest_filter=DeadlineScheduler.orders_by_deadline_or_rate" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(DeadlineScheduler.orders_by_deadline_or_rate PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Dispatcher.delivers_in_connection_order "/root/repo/_warn_build/unittest-all" "--gtest_filter=Dispatcher.delivers_in_connection_order" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Dispatcher.delivers_in_connection_order PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Dispatcher.can_store_large_targets "/root/repo/_warn_build/unittest-all" "--gtest_filter=Dispatcher.can_store_large_targets" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Dispatcher.can_store_large_targets PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Dispatcher.can_block_unblock_and_disconnect "/root/repo/_warn_build/unittest-all" "--gtest_filter=Dispatcher.can_block_unblock_and_disconnect" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Dispatcher.can_block_unblock_and_disconnect PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Dispatcher.connection_outlives_dispatcher "/root/repo/_warn_build/unittest-all" "--gtest_filter=Dispatcher.connection_outlives_dispatcher" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Dispatcher.connection_outlives_dispatcher PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Dispatcher.can_change_connections_during_emit "/root/repo/_warn_build/unittest-all" "--gtest_filter=Dispatcher.can_change_connections_during_emit" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Dispatcher.can_change_connections_during_emit PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_pub_and_sub "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_pub_and_sub" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_pub_and_sub PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_route_between_routers "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_route_between_routers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_route_between_routers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_use_queueing_delivery_policy "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_use_queueing_delivery_policy" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_use_queueing_delivery_policy PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.interns_topics "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.interns_topics" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.interns_topics PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_pub_and_sub_with_topic_ids "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_pub_and_sub_with_topic_ids" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_pub_and_sub_with_topic_ids PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_route_between_topic_ids "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_route_between_topic_ids" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_route_between_topic_ids PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.queued_events_keep_topic "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.queued_events_keep_topic" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.queued_events_keep_topic PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_pub_and_sub_with_channel "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_pub_and_sub_with_channel" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_pub_and_sub_with_channel PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.channels_work_alongside_untyped_subscribers "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.channels_work_alongside_untyped_subscribers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.channels_work_alongside_untyped_subscribers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.channels_respect_queueing_delivery_policy "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.channels_respect_queueing_delivery_policy" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.channels_respect_queueing_delivery_policy PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.channel_type_must_match "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.channel_type_must_match" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.channel_type_must_match PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_block_and_unsubscribe "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_block_and_unsubscribe" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_block_and_unsubscribe PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.conflating_queue_keeps_latest_value "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.conflating_queue_keeps_latest_value" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.conflating_queue_keeps_latest_value PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_grows_in_order "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_grows_in_order" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_grows_in_order PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_delivers_typed_values "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_delivers_typed_values" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_delivers_typed_values PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_can_drop_on_overflow "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_can_drop_on_overflow" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_can_drop_on_overflow PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_can_spill_to_conflate "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_can_spill_to_conflate" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_can_spill_to_conflate PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_keeps_spilled_topics_in_order "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_keeps_spilled_topics_in_order" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_keeps_spilled_topics_in_order PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_removes_listeners_after_notifying "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_removes_listeners_after_notifying" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_removes_listeners_after_notifying PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_can_block_producer "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_can_block_producer" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_can_block_producer PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_delivers_by_priority "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_delivers_by_priority" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_delivers_by_priority PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.event_queue_drops_lowest_priority_first "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.event_queue_drops_lowest_priority_first" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.event_queue_drops_lowest_priority_first PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_subscribe_to_patterns "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_subscribe_to_patterns" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_subscribe_to_patterns PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_block_and_unsubscribe_patterns "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_block_and_unsubscribe_patterns" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_block_and_unsubscribe_patterns PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.can_route_patterns "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.can_route_patterns" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.can_route_patterns PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.resolves_routed_pattern_topics_when_matched "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.resolves_routed_pattern_topics_when_matched" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.resolves_routed_pattern_topics_when_matched PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.cannot_publish_to_patterns "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.cannot_publish_to_patterns" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.cannot_publish_to_patterns PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(EventRouter.supports_concurrent_publishers "/root/repo/_warn_build/unittest-all" "--gtest_filter=EventRouter.supports_concurrent_publishers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(EventRouter.supports_concurrent_publishers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.can_create_and_receive_messages "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.can_create_and_receive_messages" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.can_create_and_receive_messages PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.can_conflate_bindings "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.can_conflate_bindings" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.can_conflate_bindings PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.binds_a_topic_with_different_types "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.binds_a_topic_with_different_types" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.binds_a_topic_with_different_types PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.fails_to_cast_untyped_values_when_processing "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.fails_to_cast_untyped_values_when_processing" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.fails_to_cast_untyped_values_when_processing PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.can_bound_queue "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.can_bound_queue" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.can_bound_queue PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.processes_high_priority_bindings_first "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.processes_high_priority_bindings_first" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.processes_high_priority_bindings_first PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Module.join_fires_once_per_complete_cycle "/root/repo/_warn_build/unittest-all" "--gtest_filter=Module.join_fires_once_per_complete_cycle" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Module.join_fires_once_per_complete_cycle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.can_instantiate_module "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.can_instantiate_module" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.can_instantiate_module PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.runs_modules_on_worker_threads "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.runs_modules_on_worker_threads" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.runs_modules_on_worker_threads PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.does_not_schedule_while_workers_run "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.does_not_schedule_while_workers_run" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.does_not_schedule_while_workers_run PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.can_schedule_after_stopping_workers "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.can_schedule_after_stopping_workers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.can_schedule_after_stopping_workers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.ready_set_scheduler_is_round_robin "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.ready_set_scheduler_is_round_robin" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.ready_set_scheduler_is_round_robin PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.ready_set_scheduler_resumes_after_workers_stop "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.ready_set_scheduler_resumes_after_workers_stop" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.ready_set_scheduler_resumes_after_workers_stop PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.run_wakes_for_events "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.run_wakes_for_events" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.run_wakes_for_events PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.run_for_parks_until_timeout "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.run_for_parks_until_timeout" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.run_for_parks_until_timeout PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.run_watches_descriptors "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.run_watches_descriptors" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.run_watches_descriptors PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.records_module_telemetry "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.records_module_telemetry" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.records_module_telemetry PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.latency_histogram_buckets_by_power_of_two "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.latency_histogram_buckets_by_power_of_two" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.latency_histogram_buckets_by_power_of_two PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.run_fires_timers "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.run_fires_timers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.run_fires_timers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Supervisor.runs_faster_than_real_time_on_a_simulated_clock "/root/repo/_warn_build/unittest-all" "--gtest_filter=Supervisor.runs_faster_than_real_time_on_a_simulated_clock" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Supervisor.runs_faster_than_real_time_on_a_simulated_clock PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimerWheel.fires_timers_when_due "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimerWheel.fires_timers_when_due" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimerWheel.fires_timers_when_due PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimerWheel.can_cancel_timers "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimerWheel.can_cancel_timers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimerWheel.can_cancel_timers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimerWheel.repeats_periodic_timers "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimerWheel.repeats_periodic_timers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimerWheel.repeats_periodic_timers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Timestamp.can_create_timestamp "/root/repo/_warn_build/unittest-all" "--gtest_filter=Timestamp.can_create_timestamp" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Timestamp.can_create_timestamp PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Timestamp.can_create_timestamped_set "/root/repo/_warn_build/unittest-all" "--gtest_filter=Timestamp.can_create_timestamped_set" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Timestamp.can_create_timestamped_set PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Timestamp.can_nest_timestamped_set "/root/repo/_warn_build/unittest-all" "--gtest_filter=Timestamp.can_nest_timestamped_set" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Timestamp.can_nest_timestamped_set PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Timestamp.incremental_set_tracks_assignments "/root/repo/_warn_build/unittest-all" "--gtest_filter=Timestamp.incremental_set_tracks_assignments" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Timestamp.incremental_set_tracks_assignments PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(Timestamp.incremental_set_forgets_destroyed_members "/root/repo/_warn_build/unittest-all" "--gtest_filter=Timestamp.incremental_set_forgets_destroyed_members" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(Timestamp.incremental_set_forgets_destroyed_members PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimestampedHistory.keeps_latest_samples_in_order "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimestampedHistory.keeps_latest_samples_in_order" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimestampedHistory.keeps_latest_samples_in_order PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimestampedHistory.interpolates_between_samples "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimestampedHistory.interpolates_between_samples" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimestampedHistory.interpolates_between_samples PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TimestampedHistory.can_bind_to_module "/root/repo/_warn_build/unittest-all" "--gtest_filter=TimestampedHistory.can_bind_to_module" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TimestampedHistory.can_bind_to_module PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TopicTrie.splits_segments "/root/repo/_warn_build/unittest-all" "--gtest_filter=TopicTrie.splits_segments" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TopicTrie.splits_segments PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TopicTrie.matches_wildcards "/root/repo/_warn_build/unittest-all" "--gtest_filter=TopicTrie.matches_wildcards" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TopicTrie.matches_wildcards PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(TopicTrie.finds_each_matching_pattern_once "/root/repo/_warn_build/unittest-all" "--gtest_filter=TopicTrie.finds_each_matching_pattern_once" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(TopicTrie.finds_each_matching_pattern_once PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.can_enq_and_deq_without_blocking "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.can_enq_and_deq_without_blocking" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.can_enq_and_deq_without_blocking PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.can_enq_in_one_thread_deq_in_other "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.can_enq_in_one_thread_deq_in_other" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.can_enq_in_one_thread_deq_in_other PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.can_have_multiple_readers_and_writers "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.can_have_multiple_readers_and_writers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.can_have_multiple_readers_and_writers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.can_deq_in_batches "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.can_deq_in_batches" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.can_deq_in_batches PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.can_deq_with_timeout "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.can_deq_with_timeout" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.can_deq_with_timeout PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(blocking_queue.close_releases_waiters "/root/repo/_warn_build/unittest-all" "--gtest_filter=blocking_queue.close_releases_waiters" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(blocking_queue.close_releases_waiters PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ring_queue.can_enq_and_deq_without_blocking "/root/repo/_warn_build/unittest-all" "--gtest_filter=ring_queue.can_enq_and_deq_without_blocking" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ring_queue.can_enq_and_deq_without_blocking PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ring_queue.try_enq_fails_when_full "/root/repo/_warn_build/unittest-all" "--gtest_filter=ring_queue.try_enq_fails_when_full" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ring_queue.try_enq_fails_when_full PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ring_queue.can_deq_n "/root/repo/_warn_build/unittest-all" "--gtest_filter=ring_queue.can_deq_n" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ring_queue.can_deq_n PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ring_queue.spsc_preserves_order_across_threads "/root/repo/_warn_build/unittest-all" "--gtest_filter=ring_queue.spsc_preserves_order_across_threads" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ring_queue.spsc_preserves_order_across_threads PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(ring_queue.mpsc_delivers_from_multiple_producers "/root/repo/_warn_build/unittest-all" "--gtest_filter=ring_queue.mpsc_delivers_from_multiple_producers" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(ring_queue.mpsc_delivers_from_multiple_producers PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoReader.can_read_byte "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoReader.can_read_byte" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoReader.can_read_byte PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoReader.can_read_double_byte "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoReader.can_read_double_byte" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoReader.can_read_double_byte PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoReader.can_read_data "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoReader.can_read_data" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoReader.can_read_data PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoReader.error_when_reading_past_end_of_file "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoReader.error_when_reading_past_end_of_file" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoReader.error_when_reading_past_end_of_file PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoReader.chaining_reads "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoReader.chaining_reads" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoReader.chaining_reads PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoWriter.can_write_byte "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoWriter.can_write_byte" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoWriter.can_write_byte PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoWriter.can_write_double_byte "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoWriter.can_write_double_byte" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoWriter.can_write_double_byte PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoWriter.can_write_data_with_array "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoWriter.can_write_data_with_array" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoWriter.can_write_data_with_array PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoWriter.can_write_data_with_vector "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoWriter.can_write_data_with_vector" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoWriter.can_write_data_with_vector PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(MemoryIoWriter.chaining_writes "/root/repo/_warn_build/unittest-all" "--gtest_filter=MemoryIoWriter.chaining_writes" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(MemoryIoWriter.chaining_writes PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+add_test(SpanIoReader.reads_borrowed_bytes "/root/repo/_warn_build/unittest-all" "--gtest_filter=SpanIoReader.reads_borrowed_bytes" "/root/repo/Sources/Tests/Config/ConfigTest.cpp")
+set_tests_properties(SpanIoReader.reads_borrowed_bytes PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/Sources/CMakeLists.txt;43;gtest_add_tests;/root/repo/Sources/CMakeLists.txt;0;")
+subdirs("Config")
+subdirs("System")
+subdirs("Modbus")
+subdirs("Geometry")
+subdirs("Doc")
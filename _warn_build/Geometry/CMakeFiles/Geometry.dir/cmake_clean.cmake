@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Geometry.dir/Geometry.cpp.o"
+  "CMakeFiles/Geometry.dir/Geometry.cpp.o.d"
+  "libGeometry.a"
+  "libGeometry.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Geometry.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Modbus.dir/ModbusClient.cpp.o"
+  "CMakeFiles/Modbus.dir/ModbusClient.cpp.o.d"
+  "CMakeFiles/Modbus.dir/ModbusLoopbackServer.cpp.o"
+  "CMakeFiles/Modbus.dir/ModbusLoopbackServer.cpp.o.d"
+  "CMakeFiles/Modbus.dir/ModbusServer.cpp.o"
+  "CMakeFiles/Modbus.dir/ModbusServer.cpp.o.d"
+  "libModbus.a"
+  "libModbus.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Modbus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Sources/System/Clock.cpp" "System/CMakeFiles/System.dir/Clock.cpp.o" "gcc" "System/CMakeFiles/System.dir/Clock.cpp.o.d"
+  "/root/repo/Sources/System/EventRouter.cpp" "System/CMakeFiles/System.dir/EventRouter.cpp.o" "gcc" "System/CMakeFiles/System.dir/EventRouter.cpp.o.d"
+  "/root/repo/Sources/System/Reactor.cpp" "System/CMakeFiles/System.dir/Reactor.cpp.o" "gcc" "System/CMakeFiles/System.dir/Reactor.cpp.o.d"
+  "/root/repo/Sources/System/Supervisor.cpp" "System/CMakeFiles/System.dir/Supervisor.cpp.o" "gcc" "System/CMakeFiles/System.dir/Supervisor.cpp.o.d"
+  "/root/repo/Sources/System/TimerWheel.cpp" "System/CMakeFiles/System.dir/TimerWheel.cpp.o" "gcc" "System/CMakeFiles/System.dir/TimerWheel.cpp.o.d"
+  "/root/repo/Sources/System/WorkerPool.cpp" "System/CMakeFiles/System.dir/WorkerPool.cpp.o" "gcc" "System/CMakeFiles/System.dir/WorkerPool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/System.dir/Clock.cpp.o"
+  "CMakeFiles/System.dir/Clock.cpp.o.d"
+  "CMakeFiles/System.dir/EventRouter.cpp.o"
+  "CMakeFiles/System.dir/EventRouter.cpp.o.d"
+  "CMakeFiles/System.dir/Reactor.cpp.o"
+  "CMakeFiles/System.dir/Reactor.cpp.o.d"
+  "CMakeFiles/System.dir/Supervisor.cpp.o"
+  "CMakeFiles/System.dir/Supervisor.cpp.o.d"
+  "CMakeFiles/System.dir/TimerWheel.cpp.o"
+  "CMakeFiles/System.dir/TimerWheel.cpp.o.d"
+  "CMakeFiles/System.dir/WorkerPool.cpp.o"
+  "CMakeFiles/System.dir/WorkerPool.cpp.o.d"
+  "libSystem.a"
+  "libSystem.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/System.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()